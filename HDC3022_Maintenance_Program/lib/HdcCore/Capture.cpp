@@ -0,0 +1,125 @@
+#include "Capture.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// FORMAT / PARSE
+// ============================================================================
+
+long captureToMilli(double value) {
+  return (long)(value >= 0 ? value * 1000.0 + 0.5 : value * 1000.0 - 0.5);
+}
+
+double captureFromMilli(long value) {
+  return value / 1000.0;
+}
+
+int formatCaptureRecord(const CaptureRecord& record, char* buf, size_t len) {
+  return snprintf(buf, len, CAPTURE_LINE_PREFIX "%lu,%c,%ld,%ld",
+                  record.ms, record.type, record.a, record.b);
+}
+
+bool parseCaptureLine(const char* line, CaptureRecord& record) {
+  const char* start = strstr(line, CAPTURE_LINE_PREFIX);
+  if (start == NULL) return false;
+
+  record.a = 0;
+  record.b = 0;
+  int fields = sscanf(start, CAPTURE_LINE_PREFIX "%lu,%c,%ld,%ld",
+                      &record.ms, &record.type, &record.a, &record.b);
+  if (fields < 2) return false;
+
+  switch (record.type) {
+    case CAP_BEGIN:
+    case CAP_READ:
+    case CAP_READ_FAIL:
+    case CAP_HEATER:
+    case CAP_MEASURE_MODE:
+    case CAP_OFFSET_WRITE:
+    case CAP_END:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// ============================================================================
+// RECORDING BACKEND
+// ============================================================================
+
+RecordingBackend::RecordingBackend(HdcBackend& inner, CaptureSink& sink)
+  : inner(inner), sink(sink), startMs(0) {
+}
+
+void RecordingBackend::record(char type, long a, long b) {
+  CaptureRecord r;
+  r.ms = inner.millis() - startMs;
+  r.type = type;
+  r.a = a;
+  r.b = b;
+
+  char line[CAPTURE_LINE_MAX];
+  formatCaptureRecord(r, line, sizeof(line));
+  sink.writeLine(line);
+}
+
+void RecordingBackend::begin(MaintenanceOperation operation, const char* recipeName) {
+  startMs = inner.millis();
+  if (recipeName == NULL) {
+    record(CAP_BEGIN, (long)operation, 0);
+    return;
+  }
+
+  // Parsers read the first five fields and ignore the name
+  CaptureRecord r;
+  r.ms = 0;
+  r.type = CAP_BEGIN;
+  r.a = (long)operation;
+  r.b = 1;
+  char line[CAPTURE_LINE_MAX];
+  int n = formatCaptureRecord(r, line, sizeof(line));
+  snprintf(line + n, sizeof(line) - n, ",%s", recipeName);
+  sink.writeLine(line);
+}
+
+void RecordingBackend::end(bool success) {
+  record(CAP_END, success ? 1 : 0, 0);
+}
+
+bool RecordingBackend::readTemperatureHumidity(double& temperature, double& humidity) {
+  bool ok = inner.readTemperatureHumidity(temperature, humidity);
+  if (ok) {
+    record(CAP_READ, captureToMilli(temperature), captureToMilli(humidity));
+  } else {
+    record(CAP_READ_FAIL, 0, 0);
+  }
+  return ok;
+}
+
+bool RecordingBackend::heaterEnable(HdcHeaterPower power) {
+  record(CAP_HEATER, (long)power, 0);
+  return inner.heaterEnable(power);
+}
+
+bool RecordingBackend::writeOffsets(double tempOffset, double humidityOffset) {
+  record(CAP_OFFSET_WRITE, captureToMilli(tempOffset), captureToMilli(humidityOffset));
+  return inner.writeOffsets(tempOffset, humidityOffset);
+}
+
+bool RecordingBackend::readOffsets(double& tempOffset, double& humidityOffset) {
+  return inner.readOffsets(tempOffset, humidityOffset);
+}
+
+void RecordingBackend::setMeasureMode(HdcMeasureMode mode) {
+  record(CAP_MEASURE_MODE, (long)mode, 0);
+  inner.setMeasureMode(mode);
+}
+
+unsigned long RecordingBackend::millis() {
+  return inner.millis();
+}
+
+void RecordingBackend::delay(unsigned long ms) {
+  inner.delay(ms);
+}
@@ -0,0 +1,93 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "HdcBackend.h"
+#include "Maintenance.h"
+
+// ============================================================================
+// MAINTENANCE RUN CAPTURE
+// Every backend call made during an operation is written as one text line:
+//
+//   CAP,<ms>,<type>,<a>,<b>
+//
+//   <ms>   milliseconds since the operation began
+//   <type> B = begin     a = operation (0 condensation, 1 offset correction,
+//                          2 triage, 3 combined), b = 1 if a stored recipe
+//                          ran instead (its name follows as a sixth field)
+//          R = reading   a = temperature (mC), b = humidity (m%RH)
+//          F = failed reading
+//          H = heater    a = heater power word
+//          M = mode      a = conversion mode (0..3 = LP0..LP3)
+//          W = offsets   a = temperature offset (mC), b = humidity offset (m%RH)
+//          E = end       a = 1 on success
+//
+// The lines are interleaved with the normal serial output, so a saved serial
+// log is a valid capture file. Values are integers (milli-units) so the
+// firmware never needs printf float support.
+// ============================================================================
+
+#define CAPTURE_LINE_PREFIX "CAP,"
+#define CAPTURE_LINE_MAX 64  // Room for a recipe name on the B line
+
+enum CaptureRecordType {
+  CAP_BEGIN = 'B',
+  CAP_READ = 'R',
+  CAP_READ_FAIL = 'F',
+  CAP_HEATER = 'H',
+  CAP_MEASURE_MODE = 'M',
+  CAP_OFFSET_WRITE = 'W',
+  CAP_END = 'E'
+};
+
+struct CaptureRecord {
+  unsigned long ms;
+  char type;
+  long a;
+  long b;
+};
+
+// Milli-unit conversion used by the capture format
+long captureToMilli(double value);
+double captureFromMilli(long value);
+
+// Format a record into buf (no newline). Returns the line length.
+int formatCaptureRecord(const CaptureRecord& record, char* buf, size_t len);
+// Parse a line containing "CAP,..." anywhere in it. Returns false for other lines.
+bool parseCaptureLine(const char* line, CaptureRecord& record);
+
+// Destination for capture lines (Serial on the device, a file on the host)
+class CaptureSink {
+public:
+  virtual ~CaptureSink() {}
+  virtual void writeLine(const char* line) = 0;
+};
+
+// Backend decorator that forwards to a real backend and records every call
+class RecordingBackend : public HdcBackend {
+public:
+  RecordingBackend(HdcBackend& inner, CaptureSink& sink);
+
+  // recipeName: the stored recipe standing in for the built-in procedure
+  void begin(MaintenanceOperation operation, const char* recipeName = NULL);
+  void end(bool success);
+
+  bool readTemperatureHumidity(double& temperature, double& humidity);
+  bool heaterEnable(HdcHeaterPower power);
+  bool writeOffsets(double tempOffset, double humidityOffset);
+  bool readOffsets(double& tempOffset, double& humidityOffset);
+  void setMeasureMode(HdcMeasureMode mode);
+  unsigned long millis();
+  void delay(unsigned long ms);
+
+private:
+  void record(char type, long a, long b);
+
+  HdcBackend& inner;
+  CaptureSink& sink;
+  unsigned long startMs;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef HDC_BACKEND_H
+#define HDC_BACKEND_H
+
+#include <stdint.h>
+
+// ============================================================================
+// HDC BACKEND INTERFACE
+// Everything the maintenance algorithms need from the outside world: the
+// sensor, the heater, the offset EEPROM and a clock. The firmware wraps
+// Adafruit_HDC302x + millis()/delay(); host builds substitute a replay or
+// simulated backend so the same algorithm code runs without hardware.
+// ============================================================================
+
+// Heater power levels (values match the HDC302x heater configuration words)
+enum HdcHeaterPower {
+  HDC_HEATER_OFF = 0x0000,
+  HDC_HEATER_QUARTER_POWER = 0x009F,
+  HDC_HEATER_HALF_POWER = 0x03FF,
+  HDC_HEATER_FULL_POWER = 0x3FFF
+};
+
+// On-demand conversion modes. LP0 is the slowest, lowest-noise conversion;
+// each step up to LP3 is faster and noisier.
+enum HdcMeasureMode {
+  HDC_MODE_LP0 = 0,
+  HDC_MODE_LP1,
+  HDC_MODE_LP2,
+  HDC_MODE_LP3
+};
+
+#define HDC_MODE_COUNT 4
+
+class HdcBackend {
+public:
+  virtual ~HdcBackend() {}
+
+  // Sensor access - all return false on a bus/sensor error
+  virtual bool readTemperatureHumidity(double& temperature, double& humidity) = 0;
+  virtual bool heaterEnable(HdcHeaterPower power) = 0;
+  virtual bool writeOffsets(double tempOffset, double humidityOffset) = 0;
+  virtual bool readOffsets(double& tempOffset, double& humidityOffset) = 0;
+
+  // Conversion mode for the following reads (backends that can't change
+  // it ignore this)
+  virtual void setMeasureMode(HdcMeasureMode mode) {}
+
+  // Time base - real time on the device, virtual time on the host
+  virtual unsigned long millis() = 0;
+  virtual void delay(unsigned long ms) = 0;
+};
+
+#endif
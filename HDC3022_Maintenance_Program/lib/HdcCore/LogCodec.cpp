@@ -0,0 +1,236 @@
+#include "LogCodec.h"
+
+#include <string.h>
+
+// ============================================================================
+// CRC-32 (nibble table - 64 bytes of flash, fast enough for USB rates)
+// ============================================================================
+
+static const uint32_t CRC_NIBBLE_TABLE[16] = {
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+  0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+  0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+uint32_t logCrc32(uint32_t crc, const uint8_t* data, size_t len) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) {
+    crc = CRC_NIBBLE_TABLE[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+    crc = CRC_NIBBLE_TABLE[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+  }
+  return ~crc;
+}
+
+// ============================================================================
+// DELTA + VARINT
+// ============================================================================
+
+static size_t putVarint(uint8_t* out, uint32_t value) {
+  size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = (uint8_t)value;
+  return n;
+}
+
+static bool getVarint(const uint8_t* in, size_t len, size_t& pos, uint32_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (pos >= len) return false;
+    uint8_t b = in[pos++];
+    value |= (uint32_t)(b & 0x7F) << shift;
+    if ((b & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+static uint32_t zigzag(int32_t v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+size_t logDeltaEncode(const LogRecord* records, size_t count, uint8_t* out) {
+  LogRecord prev;
+  memset(&prev, 0, sizeof(prev));
+  size_t n = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    const LogRecord& r = records[i];
+    n += putVarint(out + n, zigzag((int32_t)(r.uptimeSec - prev.uptimeSec)));
+    n += putVarint(out + n, zigzag((int16_t)(r.boot - prev.boot)));
+    out[n++] = r.type;
+    out[n++] = r.flags;
+    n += putVarint(out + n, zigzag(r.a - prev.a));
+    n += putVarint(out + n, zigzag(r.b - prev.b));
+    prev = r;
+  }
+  return n;
+}
+
+bool logDeltaDecode(const uint8_t* in, size_t len, LogRecord* records, size_t count) {
+  LogRecord prev;
+  memset(&prev, 0, sizeof(prev));
+  size_t pos = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    uint32_t v;
+    LogRecord r;
+
+    if (!getVarint(in, len, pos, v)) return false;
+    r.uptimeSec = prev.uptimeSec + (uint32_t)unzigzag(v);
+    if (!getVarint(in, len, pos, v)) return false;
+    r.boot = (uint16_t)(prev.boot + unzigzag(v));
+    if (pos + 2 > len) return false;
+    r.type = in[pos++];
+    r.flags = in[pos++];
+    if (!getVarint(in, len, pos, v)) return false;
+    r.a = (int16_t)(prev.a + unzigzag(v));
+    if (!getVarint(in, len, pos, v)) return false;
+    r.b = (int16_t)(prev.b + unzigzag(v));
+
+    records[i] = r;
+    prev = r;
+  }
+  return pos == len;
+}
+
+// ============================================================================
+// LZ COMPRESSION
+// Greedy longest match in the previous 256 bytes. Steady 1 Hz data delta
+// encodes to a short repeating pattern, which this collapses to a few bytes
+// per hundred records.
+// ============================================================================
+
+#define LZ_WINDOW 256
+#define LZ_MIN_MATCH 3
+#define LZ_MAX_MATCH (255 + LZ_MIN_MATCH)
+
+size_t logCompress(const uint8_t* in, size_t len, uint8_t* out) {
+  size_t pos = 0;
+  size_t n = 0;
+
+  while (pos < len) {
+    size_t controlPos = n++;
+    uint8_t control = 0;
+
+    for (int bit = 0; bit < 8 && pos < len; bit++) {
+      size_t bestLen = 0;
+      size_t bestOffset = 0;
+      size_t windowStart = pos > LZ_WINDOW ? pos - LZ_WINDOW : 0;
+      size_t maxLen = len - pos < LZ_MAX_MATCH ? len - pos : LZ_MAX_MATCH;
+
+      for (size_t cand = windowStart; cand < pos; cand++) {
+        size_t m = 0;
+        // Overlapping matches are allowed (run-length behaviour)
+        while (m < maxLen && in[cand + m] == in[pos + m]) m++;
+        if (m > bestLen) {
+          bestLen = m;
+          bestOffset = pos - cand;
+          if (m == maxLen) break;
+        }
+      }
+
+      if (bestLen >= LZ_MIN_MATCH) {
+        control |= (uint8_t)(1 << bit);
+        out[n++] = (uint8_t)(bestOffset - 1);
+        out[n++] = (uint8_t)(bestLen - LZ_MIN_MATCH);
+        pos += bestLen;
+      } else {
+        out[n++] = in[pos++];
+      }
+    }
+    out[controlPos] = control;
+  }
+  return n;
+}
+
+size_t logDecompress(const uint8_t* in, size_t len, uint8_t* out, size_t outMax) {
+  size_t pos = 0;
+  size_t n = 0;
+
+  while (pos < len) {
+    uint8_t control = in[pos++];
+
+    for (int bit = 0; bit < 8 && pos < len; bit++) {
+      if (control & (1 << bit)) {
+        if (pos + 2 > len) return 0;
+        size_t offset = (size_t)in[pos++] + 1;
+        size_t matchLen = (size_t)in[pos++] + LZ_MIN_MATCH;
+        if (offset > n || n + matchLen > outMax) return 0;
+        for (size_t i = 0; i < matchLen; i++, n++) {
+          out[n] = out[n - offset];
+        }
+      } else {
+        if (n >= outMax) return 0;
+        out[n++] = in[pos++];
+      }
+    }
+  }
+  return n;
+}
+
+// ============================================================================
+// CHUNKS
+// ============================================================================
+
+static void putU16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void putU32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t getU16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+size_t logBuildChunk(uint32_t firstSeq, const LogRecord* records, size_t count,
+                     uint8_t* scratch, uint8_t* out) {
+  if (count > LOG_CHUNK_MAX_RECORDS) count = LOG_CHUNK_MAX_RECORDS;
+
+  size_t rawLen = logDeltaEncode(records, count, scratch);
+  size_t payloadLen = logCompress(scratch, rawLen, out + LOG_CHUNK_HEADER_SIZE);
+
+  out[0] = LOG_CHUNK_MAGIC0;
+  out[1] = LOG_CHUNK_MAGIC1;
+  putU32(out + 2, firstSeq);
+  putU16(out + 6, (uint16_t)count);
+  putU16(out + 8, (uint16_t)payloadLen);
+
+  size_t size = LOG_CHUNK_HEADER_SIZE + payloadLen;
+  putU32(out + size, logCrc32(0, out, size));
+  return size + LOG_CHUNK_CRC_SIZE;
+}
+
+bool logParseChunk(const uint8_t* chunk, size_t len, uint8_t* scratch, uint32_t& firstSeq,
+                   LogRecord* records, size_t& count) {
+  if (len < LOG_CHUNK_HEADER_SIZE + LOG_CHUNK_CRC_SIZE) return false;
+  if (chunk[0] != LOG_CHUNK_MAGIC0 || chunk[1] != LOG_CHUNK_MAGIC1) return false;
+
+  firstSeq = getU32(chunk + 2);
+  count = getU16(chunk + 6);
+  size_t payloadLen = getU16(chunk + 8);
+  size_t size = LOG_CHUNK_HEADER_SIZE + payloadLen;
+  if (count > LOG_CHUNK_MAX_RECORDS || payloadLen > LOG_CHUNK_MAX_PAYLOAD) return false;
+  if (len != size + LOG_CHUNK_CRC_SIZE) return false;
+  if (logCrc32(0, chunk, size) != getU32(chunk + size)) return false;
+
+  if (count == 0) return true;
+  size_t rawLen = logDecompress(chunk + LOG_CHUNK_HEADER_SIZE, payloadLen, scratch, LOG_CHUNK_MAX_RAW);
+  return rawLen != 0 && logDeltaDecode(scratch, rawLen, records, count);
+}
@@ -0,0 +1,79 @@
+#ifndef LOG_CODEC_H
+#define LOG_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// SAMPLE LOG RECORDS AND EXPORT CODEC
+// Shared by the firmware (flash log + USB export) and the host decoder.
+//
+// Export stream, after the "EXPORT <first> <count>" text line:
+//
+//   chunk := 'H' 'X' | first seq (u32) | record count (u16) | payload len (u16)
+//            | payload | CRC-32 of everything before it (u32)
+//
+// All integers little-endian. A chunk with record count 0 ends the export.
+// The payload is the chunk's records delta-encoded against the previous
+// record (zigzag varints), then LZ-compressed with a 256 byte window.
+// ============================================================================
+
+// One 12 byte log record - the unit stored in flash
+enum LogRecordType {
+  LOG_SAMPLE = 1,     // a = temperature (cC), b = humidity (c%RH)
+  LOG_OPERATION = 2   // flags = operation | verdict << 4 | LOG_FLAG_SUCCESS,
+                      // a = duration (s), b = humidity offset (c%RH;
+                      // triage: estimated RH error)
+};
+
+#define LOG_FLAG_SUCCESS 0x80
+#define LOG_OPERATION_MASK 0x0F
+#define LOG_VERDICT_SHIFT 4  // Triage verdict (TriageVerdict), bits 4..5
+
+struct LogRecord {
+  uint32_t uptimeSec;
+  uint16_t boot;
+  uint8_t type;
+  uint8_t flags;
+  int16_t a;
+  int16_t b;
+};
+
+// Chunk layout
+#define LOG_CHUNK_MAGIC0 'H'
+#define LOG_CHUNK_MAGIC1 'X'
+#define LOG_CHUNK_HEADER_SIZE 10
+#define LOG_CHUNK_CRC_SIZE 4
+#define LOG_CHUNK_MAX_RECORDS 256
+// Worst case delta encoding is 16 bytes per record
+#define LOG_CHUNK_MAX_RAW (LOG_CHUNK_MAX_RECORDS * 16)
+// LZ worst case adds one control byte per 8 literals
+#define LOG_CHUNK_MAX_PAYLOAD (LOG_CHUNK_MAX_RAW + LOG_CHUNK_MAX_RAW / 8 + 1)
+#define LOG_CHUNK_MAX_SIZE (LOG_CHUNK_HEADER_SIZE + LOG_CHUNK_MAX_PAYLOAD + LOG_CHUNK_CRC_SIZE)
+
+// CRC-32 (IEEE 802.3, reflected). Pass 0 to start, the previous result to continue.
+uint32_t logCrc32(uint32_t crc, const uint8_t* data, size_t len);
+
+// Delta + zigzag varint encoding of a record run. Returns bytes written.
+size_t logDeltaEncode(const LogRecord* records, size_t count, uint8_t* out);
+// Inverse of logDeltaEncode. Returns false on malformed input.
+bool logDeltaDecode(const uint8_t* in, size_t len, LogRecord* records, size_t count);
+
+// LZ compression (control byte per 8 tokens; match = offset-1, length-3).
+// out must hold len + len / 8 + 1 bytes. Returns compressed size.
+size_t logCompress(const uint8_t* in, size_t len, uint8_t* out);
+// Returns decompressed size, or 0 if the input is malformed or overflows out.
+size_t logDecompress(const uint8_t* in, size_t len, uint8_t* out, size_t outMax);
+
+// Build a complete chunk (header, payload, CRC) into out (LOG_CHUNK_MAX_SIZE
+// bytes). scratch must hold LOG_CHUNK_MAX_RAW bytes. Returns the chunk size.
+size_t logBuildChunk(uint32_t firstSeq, const LogRecord* records, size_t count,
+                     uint8_t* scratch, uint8_t* out);
+// Inverse of logBuildChunk for a whole chunk of len bytes. records must hold
+// LOG_CHUNK_MAX_RECORDS, scratch LOG_CHUNK_MAX_RAW bytes. The end-of-export
+// chunk parses with count 0. Returns false if it is malformed or the CRC
+// doesn't match.
+bool logParseChunk(const uint8_t* chunk, size_t len, uint8_t* scratch, uint32_t& firstSeq,
+                   LogRecord* records, size_t& count);
+
+#endif
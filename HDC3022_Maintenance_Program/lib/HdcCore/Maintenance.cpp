@@ -0,0 +1,851 @@
+#include "Maintenance.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#include "Recipe.h"
+
+// ============================================================================
+// TABLES AND DEFAULTS
+// ============================================================================
+
+const float OFFSET_RISE_LUT[OFFSET_LUT_ROWS][OFFSET_LUT_COLS] = {
+  {32.99, 30.94, 31.78, 31.92},  // 10% RH
+  {36.36, 34.06, 36.43, 37.85},  // 15% RH
+  {40.33, 38.16, 41.44, 43.37},  // 20% RH
+  {44.13, 42.31, 45.45, 46.89},  // 25% RH
+  {47.14, 45.81, 48.01, 48.39},  // 30% RH
+  {49.34, 48.52, 49.26, 48.99},  // 35% RH
+  {50.29, 49.79, 49.83, 49.06},  // 40% RH
+  {50.79, 50.34, 49.89, 49.06}   // 45% RH
+};
+
+const CondensationParams DEFAULT_CONDENSATION_PARAMS = {
+  HDC_HEATER_HALF_POWER,
+  5000,    // 5 seconds between readings
+  300000,  // 5 minutes
+  10000,   // 10 second cooldown
+  1.0,
+  10.0,
+  { HDC_MODE_LP0, HDC_MODE_LP3, HDC_MODE_LP0 }  // Low noise at rest, fast on the ramp
+};
+
+const OffsetCorrectionParams DEFAULT_OFFSET_PARAMS = {
+  HDC_HEATER_FULL_POWER,
+  2000,    // 2 seconds between readings
+  120000,  // 2 minutes
+  10000,   // 10 second cooldown
+  OFFSET_RISE_LUT,
+  { HDC_MODE_LP0, HDC_MODE_LP3, HDC_MODE_LP0 }  // The offset itself comes from an LP0 read
+};
+
+const TriageParams DEFAULT_TRIAGE_PARAMS = {
+  HDC_HEATER_FULL_POWER,
+  1000,    // 1 second between readings
+  15000,   // Pulse never longer than 15 seconds
+  20.0,    // ...or 20C above ambient
+  5000,    // 5 second cooldown (less heat to shed than a full correction)
+  4,       // Average 4 readings at each end
+  1.0,     // Offset correction above 1 %RH error
+  10.0,    // Condensate above 10 %RH...
+  95.0,    // ...or if it reads (near) saturated before heating
+  { HDC_MODE_LP0, HDC_MODE_LP3, HDC_MODE_LP0 }
+};
+
+// Below this fall in RH ratio across the pulse (1 - k) the error estimate
+// is mostly noise
+#define TRIAGE_MIN_CONTRAST 0.2
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+// Table index for value on a grid starting at origin, clamped to the table.
+// Clamping happens before the float -> int conversion, so NaN and huge
+// readings (a failed or garbage read) land on an edge instead of being UB.
+static int lutIndex(double value, double origin, double step, int count) {
+  double pos = (value - origin) / step;
+  if (!(pos >= 1.0)) return 0;  // Below the second entry, or NaN
+  if (pos >= count - 1) return count - 1;
+  return (int)pos;
+}
+
+static const char* heaterEnabledMessage(HdcHeaterPower power) {
+  switch (power) {
+    case HDC_HEATER_FULL_POWER:
+      return "Heater enabled at FULL power";
+    case HDC_HEATER_HALF_POWER:
+      return "Heater enabled at HALF power";
+    case HDC_HEATER_QUARTER_POWER:
+      return "Heater enabled at QUARTER power";
+    default:
+      return "Heater enabled";
+  }
+}
+
+// Nominal share of full heater power (datasheet), for comparing ramps
+static double heaterPowerFraction(HdcHeaterPower power) {
+  switch (power) {
+    case HDC_HEATER_FULL_POWER:
+      return 1.0;
+    case HDC_HEATER_HALF_POWER:
+      return 0.5;
+    case HDC_HEATER_QUARTER_POWER:
+      return 0.25;
+    default:
+      return 0.0;
+  }
+}
+
+// Log why the operation failed and keep it for the result screen
+static bool fail(MaintenanceObserver& observer, MaintenanceResult& result, const char* reason) {
+  observer.onMessage(reason);
+  result.failure = reason;
+  return false;
+}
+
+static void report(MaintenanceObserver& observer, MaintenanceOperation op, MaintenanceEvent event,
+                   double temperature, double humidity, double rise, unsigned long elapsedMs) {
+  MaintenanceReport r;
+  r.operation = op;
+  r.event = event;
+  r.temperature = temperature;
+  r.humidity = humidity;
+  r.rise = rise;
+  r.elapsedMs = elapsedMs;
+  observer.onReport(r);
+}
+
+float offsetTargetRise(const float (*lut)[OFFSET_LUT_COLS], double ambientTemp, double ambientHumidity) {
+  int tempCol = lutIndex(ambientTemp, 15.0, 5.0, OFFSET_LUT_COLS);
+  int humRow = lutIndex(ambientHumidity, 10.0, 5.0, OFFSET_LUT_ROWS);
+  return lut[humRow][tempCol];
+}
+
+// ============================================================================
+// CONDENSATION REMOVAL
+// ============================================================================
+
+bool maintenanceCondensationRemoval(HdcBackend& backend, const CondensationParams& params,
+                                    MaintenanceObserver& observer, MaintenanceResult& result) {
+  const MaintenanceOperation op = MAINT_OP_CONDENSATION;
+  unsigned long opStart = backend.millis();
+  double initialTemp, initialHumidity;
+
+  result.success = false;
+  result.finalTemp = 0.0;
+  result.finalHumidity = 0.0;
+  result.tempOffset = 0.0;
+  result.humidityOffset = 0.0;
+  result.durationMs = 0;
+  result.failure = NULL;
+
+  // Step 1: Read initial conditions
+  backend.setMeasureMode(params.modes.baseline);
+  if (!backend.readTemperatureHumidity(initialTemp, initialHumidity)) {
+    return fail(observer, result, "Failed to read initial conditions");
+  }
+  report(observer, op, MAINT_EVT_INITIAL, initialTemp, initialHumidity, 0, 0);
+
+  // Step 2: Enable heater
+  if (!backend.heaterEnable(params.heaterPower)) {
+    return fail(observer, result, "Failed to enable heater");
+  }
+  observer.onMessage(heaterEnabledMessage(params.heaterPower));
+
+  // Step 3: Monitor until humidity < exit threshold or timeout
+  double currentTemp = initialTemp;
+  double currentHumidity = initialHumidity;
+  unsigned long startTime = backend.millis();
+  bool condensationRemoved = false;
+
+  observer.onProgress("CONDENSATION", "Heating...", initialTemp, initialHumidity, 0, 0);
+  backend.setMeasureMode(params.modes.ramp);
+
+  while (backend.millis() - startTime < params.timeoutMs) {
+    backend.delay(params.pollIntervalMs);
+
+    if (!backend.readTemperatureHumidity(currentTemp, currentHumidity)) {
+      observer.onMessage("Failed to read sensor during heating");
+      continue;
+    }
+
+    float heatRise = currentTemp - initialTemp;
+    unsigned long elapsedMs = backend.millis() - startTime;
+    report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, heatRise, elapsedMs);
+
+    const char* status = "Heating...";
+    if (currentHumidity < params.almostDoneHumidity) {
+      status = "Almost done!";
+    }
+    observer.onProgress("CONDENSATION", status, currentTemp, currentHumidity, heatRise, elapsedMs / 1000);
+
+    // Check if condensation is removed
+    if (currentHumidity < params.exitHumidity) {
+      observer.onMessage("Condensation removed!");
+      condensationRemoved = true;
+      break;
+    }
+  }
+
+  // Step 4: Disable heater
+  backend.heaterEnable(HDC_HEATER_OFF);
+  observer.onMessage("Heater disabled");
+
+  if (!condensationRemoved) {
+    observer.onMessage("WARNING: Timeout reached");
+    result.failure = "Timeout reached";
+  }
+
+  // Step 5: Cooldown
+  observer.onMessage("Cooling down...");
+  observer.onProgress("CONDENSATION", "Cooling...", currentTemp, currentHumidity, 0, 0);
+  backend.delay(params.cooldownMs);
+
+  // Step 6: Read final conditions
+  backend.setMeasureMode(params.modes.plateau);
+  backend.readTemperatureHumidity(result.finalTemp, result.finalHumidity);
+  result.durationMs = backend.millis() - opStart;
+  report(observer, op, MAINT_EVT_FINAL, result.finalTemp, result.finalHumidity, 0, result.durationMs);
+
+  result.success = condensationRemoved;
+  return condensationRemoved;
+}
+
+// ============================================================================
+// OFFSET ERROR CORRECTION
+// ============================================================================
+
+bool maintenanceOffsetCorrection(HdcBackend& backend, const OffsetCorrectionParams& params,
+                                 MaintenanceObserver& observer, MaintenanceResult& result) {
+  const MaintenanceOperation op = MAINT_OP_OFFSET_CORRECTION;
+  unsigned long opStart = backend.millis();
+  double initialTemp, initialHumidity;
+
+  result.success = false;
+  result.finalTemp = 0.0;
+  result.finalHumidity = 0.0;
+  result.tempOffset = 0.0;
+  result.humidityOffset = 0.0;
+  result.durationMs = 0;
+  result.failure = NULL;
+
+  // Step 1: Measure initial conditions
+  backend.setMeasureMode(params.modes.baseline);
+  if (!backend.readTemperatureHumidity(initialTemp, initialHumidity)) {
+    return fail(observer, result, "Failed to read initial conditions");
+  }
+  report(observer, op, MAINT_EVT_INITIAL, initialTemp, initialHumidity, 0, 0);
+
+  // Step 2: Calculate target from LUT
+  float targetTempRise = offsetTargetRise(params.riseLut, initialTemp, initialHumidity);
+  report(observer, op, MAINT_EVT_TARGET_RISE, initialTemp, initialHumidity, targetTempRise, 0);
+
+  // Step 3: Enable heater
+  if (!backend.heaterEnable(params.heaterPower)) {
+    return fail(observer, result, "Failed to enable heater");
+  }
+  observer.onMessage(heaterEnabledMessage(params.heaterPower));
+
+  // Step 4: Monitor until target temperature
+  double currentTemp = initialTemp;
+  double currentHumidity = initialHumidity;
+  unsigned long startTime = backend.millis();
+  float heatRise = 0.0;
+
+  // Status line: "Target:+NN C" (rounded to whole degrees)
+  char status[20];
+  snprintf(status, sizeof(status), "Target:+%dC", (int)(targetTempRise + 0.5f));
+
+  observer.onProgress("OFFSET CORR.", "Heating...", initialTemp, initialHumidity, 0, 0);
+  backend.setMeasureMode(params.modes.ramp);
+
+  while (backend.millis() - startTime < params.timeoutMs) {
+    backend.delay(params.pollIntervalMs);
+
+    if (!backend.readTemperatureHumidity(currentTemp, currentHumidity)) {
+      observer.onMessage("Failed to read sensor during heating");
+      continue;
+    }
+
+    heatRise = currentTemp - initialTemp;
+    unsigned long elapsedMs = backend.millis() - startTime;
+    report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, heatRise, elapsedMs);
+    observer.onProgress("OFFSET CORR.", status, currentTemp, currentHumidity, heatRise, elapsedMs / 1000);
+
+    // Check if target reached
+    if (heatRise >= targetTempRise) {
+      observer.onMessage("Target temperature reached");
+      break;
+    }
+  }
+
+  // Step 5: Take the offset sample in the plateau mode (if the ramp used a
+  // faster one), still at the top of the ramp, then disable the heater
+  if (params.modes.plateau != params.modes.ramp) {
+    backend.setMeasureMode(params.modes.plateau);
+    double plateauTemp, plateauHumidity;
+    if (backend.readTemperatureHumidity(plateauTemp, plateauHumidity)) {
+      currentTemp = plateauTemp;
+      currentHumidity = plateauHumidity;
+      heatRise = currentTemp - initialTemp;
+      report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, heatRise,
+             backend.millis() - startTime);
+    }
+  }
+
+  backend.heaterEnable(HDC_HEATER_OFF);
+  observer.onMessage("Heater disabled");
+
+  // Step 6: Calculate offsets
+  result.humidityOffset = currentHumidity;
+  result.tempOffset = 0.0;
+  report(observer, op, MAINT_EVT_OFFSET_CALCULATED, 0, result.humidityOffset, 0, 0);
+
+  // Step 7: Write offsets to sensor
+  if (!backend.writeOffsets(result.tempOffset, -result.humidityOffset)) {
+    result.durationMs = backend.millis() - opStart;
+    return fail(observer, result, "Failed to write offsets");
+  }
+  observer.onMessage("Offsets written to sensor");
+
+  // Verify
+  double verifyTemp, verifyHum;
+  if (backend.readOffsets(verifyTemp, verifyHum)) {
+    report(observer, op, MAINT_EVT_OFFSET_VERIFIED, verifyTemp, verifyHum, 0, 0);
+  }
+
+  // Step 8: Cooldown
+  observer.onMessage("Cooling down...");
+  observer.onProgress("OFFSET CORR.", "Cooling...", currentTemp, currentHumidity, 0, 0);
+  backend.delay(params.cooldownMs);
+
+  // Step 9: Test corrected sensor
+  backend.setMeasureMode(params.modes.plateau);
+  if (backend.readTemperatureHumidity(result.finalTemp, result.finalHumidity)) {
+    report(observer, op, MAINT_EVT_CORRECTED, result.finalTemp, result.finalHumidity, 0, 0);
+  }
+  result.durationMs = backend.millis() - opStart;
+
+  result.success = true;
+  return true;
+}
+
+// ============================================================================
+// COMBINED CONDENSATION REMOVAL + OFFSET CORRECTION
+// ============================================================================
+
+bool maintenanceCombined(HdcBackend& backend, const CondensationParams& dry,
+                         const OffsetCorrectionParams& offset, MaintenanceObserver& observer,
+                         MaintenanceResult& result, CombinedResult& combined) {
+  const MaintenanceOperation op = MAINT_OP_COMBINED;
+  unsigned long opStart = backend.millis();
+  double initialTemp, initialHumidity;
+
+  result.success = false;
+  result.finalTemp = 0.0;
+  result.finalHumidity = 0.0;
+  result.tempOffset = 0.0;
+  result.humidityOffset = 0.0;
+  result.durationMs = 0;
+  result.failure = NULL;
+  combined.dryMs = 0;
+  combined.targetMs = 0;
+  combined.savedMs = 0;
+
+  // Step 1: Read initial conditions and the target rise
+  backend.setMeasureMode(dry.modes.baseline);
+  if (!backend.readTemperatureHumidity(initialTemp, initialHumidity)) {
+    return fail(observer, result, "Failed to read initial conditions");
+  }
+  report(observer, op, MAINT_EVT_INITIAL, initialTemp, initialHumidity, 0, 0);
+
+  float targetTempRise = offsetTargetRise(offset.riseLut, initialTemp, initialHumidity);
+  report(observer, op, MAINT_EVT_TARGET_RISE, initialTemp, initialHumidity, targetTempRise, 0);
+
+  // Step 2: Enable heater at the condensation removal power
+  if (!backend.heaterEnable(dry.heaterPower)) {
+    return fail(observer, result, "Failed to enable heater");
+  }
+  observer.onMessage(heaterEnabledMessage(dry.heaterPower));
+
+  // Step 3: Dry the part, noting when the rise passes the target on the way
+  double currentTemp = initialTemp;
+  double currentHumidity = initialHumidity;
+  unsigned long startTime = backend.millis();
+  float heatRise = 0.0;
+  bool dried = false;
+  bool targetReached = false;
+
+  observer.onProgress("DRY+OFFSET", "Drying...", initialTemp, initialHumidity, 0, 0);
+  backend.setMeasureMode(dry.modes.ramp);
+  HdcMeasureMode mode = dry.modes.ramp;
+
+  while (backend.millis() - startTime < dry.timeoutMs) {
+    backend.delay(dry.pollIntervalMs);
+
+    if (!backend.readTemperatureHumidity(currentTemp, currentHumidity)) {
+      observer.onMessage("Failed to read sensor during heating");
+      continue;
+    }
+
+    heatRise = currentTemp - initialTemp;
+    unsigned long elapsedMs = backend.millis() - startTime;
+    report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, heatRise, elapsedMs);
+
+    const char* status = "Drying...";
+    if (currentHumidity < dry.almostDoneHumidity) {
+      status = "Almost done!";
+    }
+    observer.onProgress("DRY+OFFSET", status, currentTemp, currentHumidity, heatRise, elapsedMs / 1000);
+
+    if (!targetReached && heatRise >= targetTempRise) {
+      targetReached = true;
+      combined.targetMs = elapsedMs;
+    }
+
+    if (currentHumidity < dry.exitHumidity) {
+      observer.onMessage("Condensation removed!");
+      dried = true;
+      combined.dryMs = elapsedMs;
+      break;
+    }
+  }
+
+  // Still wet: no offset worth writing, finish like a failed condensation removal
+  if (!dried) {
+    backend.heaterEnable(HDC_HEATER_OFF);
+    observer.onMessage("Heater disabled");
+    observer.onMessage("WARNING: Timeout reached");
+    result.failure = "Still wet, offsets not written";
+
+    observer.onMessage("Cooling down...");
+    observer.onProgress("DRY+OFFSET", "Cooling...", currentTemp, currentHumidity, 0, 0);
+    backend.delay(dry.cooldownMs);
+
+    backend.setMeasureMode(dry.modes.plateau);
+    backend.readTemperatureHumidity(result.finalTemp, result.finalHumidity);
+    result.durationMs = backend.millis() - opStart;
+    report(observer, op, MAINT_EVT_FINAL, result.finalTemp, result.finalHumidity, 0, result.durationMs);
+    return false;
+  }
+
+  // Step 4: Carry on to the target rise without cooling down
+  if (targetReached) {
+    observer.onMessage("Target temperature reached");
+  } else {
+    if (offset.heaterPower != dry.heaterPower) {
+      if (backend.heaterEnable(offset.heaterPower)) {
+        observer.onMessage(heaterEnabledMessage(offset.heaterPower));
+      } else {
+        observer.onMessage("Failed to change heater power");
+      }
+    }
+
+    char status[20];
+    snprintf(status, sizeof(status), "Target:+%dC", (int)(targetTempRise + 0.5f));
+
+    backend.setMeasureMode(offset.modes.ramp);
+    mode = offset.modes.ramp;
+    unsigned long rampStart = backend.millis();
+
+    while (backend.millis() - rampStart < offset.timeoutMs) {
+      backend.delay(offset.pollIntervalMs);
+
+      if (!backend.readTemperatureHumidity(currentTemp, currentHumidity)) {
+        observer.onMessage("Failed to read sensor during heating");
+        continue;
+      }
+
+      heatRise = currentTemp - initialTemp;
+      unsigned long elapsedMs = backend.millis() - startTime;
+      report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, heatRise, elapsedMs);
+      observer.onProgress("DRY+OFFSET", status, currentTemp, currentHumidity, heatRise, elapsedMs / 1000);
+
+      if (heatRise >= targetTempRise) {
+        observer.onMessage("Target temperature reached");
+        targetReached = true;
+        break;
+      }
+    }
+    combined.targetMs = backend.millis() - startTime;
+  }
+
+  // Step 5: Offset sample in the plateau mode, then disable the heater
+  if (offset.modes.plateau != mode) {
+    backend.setMeasureMode(offset.modes.plateau);
+    double plateauTemp, plateauHumidity;
+    if (backend.readTemperatureHumidity(plateauTemp, plateauHumidity)) {
+      currentTemp = plateauTemp;
+      currentHumidity = plateauHumidity;
+      heatRise = currentTemp - initialTemp;
+      report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, heatRise,
+             backend.millis() - startTime);
+    }
+  }
+
+  backend.heaterEnable(HDC_HEATER_OFF);
+  observer.onMessage("Heater disabled");
+
+  // Step 6: Calculate and write offsets
+  result.humidityOffset = currentHumidity;
+  result.tempOffset = 0.0;
+  report(observer, op, MAINT_EVT_OFFSET_CALCULATED, 0, result.humidityOffset, 0, 0);
+
+  if (!backend.writeOffsets(result.tempOffset, -result.humidityOffset)) {
+    result.durationMs = backend.millis() - opStart;
+    return fail(observer, result, "Failed to write offsets");
+  }
+  observer.onMessage("Offsets written to sensor");
+
+  double verifyTemp, verifyHum;
+  if (backend.readOffsets(verifyTemp, verifyHum)) {
+    report(observer, op, MAINT_EVT_OFFSET_VERIFIED, verifyTemp, verifyHum, 0, 0);
+  }
+
+  // Step 7: The one cooldown
+  observer.onMessage("Cooling down...");
+  observer.onProgress("DRY+OFFSET", "Cooling...", currentTemp, currentHumidity, 0, 0);
+  backend.delay(offset.cooldownMs);
+
+  // Step 8: Test corrected sensor
+  backend.setMeasureMode(offset.modes.plateau);
+  if (backend.readTemperatureHumidity(result.finalTemp, result.finalHumidity)) {
+    report(observer, op, MAINT_EVT_CORRECTED, result.finalTemp, result.finalHumidity, 0, 0);
+  }
+  result.durationMs = backend.millis() - opStart;
+
+  // Separately, the condensation removal cooldown would have shed the heat
+  // the offset correction then has to put back in. Early in the ramp the
+  // rise is about proportional to power, so the drying time to the target
+  // scales to the offset correction's power.
+  unsigned long reheatMs = combined.targetMs < combined.dryMs ? combined.targetMs : combined.dryMs;
+  double offsetFraction = heaterPowerFraction(offset.heaterPower);
+  if (offsetFraction > 0.0) {
+    reheatMs = (unsigned long)(reheatMs * heaterPowerFraction(dry.heaterPower) / offsetFraction);
+  }
+  combined.savedMs = dry.cooldownMs + reheatMs;
+  report(observer, op, MAINT_EVT_TIME_SAVED, 0, 0, 0, combined.savedMs);
+
+  result.success = true;
+  return true;
+}
+
+// ============================================================================
+// QUICK TRIAGE
+// ============================================================================
+
+const char* triageVerdictName(TriageVerdict verdict) {
+  switch (verdict) {
+    case TRIAGE_NEEDS_OFFSET_CORRECTION:
+      return "needs offset correction";
+    case TRIAGE_NEEDS_CONDENSATION_REMOVAL:
+      return "needs condensation removal";
+    default:
+      return "ok";
+  }
+}
+
+// Saturation vapour pressure up to a constant factor (Magnus, same fit as
+// Psychro.h) - only ratios are used
+static double saturationRatio(double fromTemp, double toTemp) {
+  return exp(17.62 * fromTemp / (243.12 + fromTemp) - 17.62 * toTemp / (243.12 + toTemp));
+}
+
+// Mean of n back-to-back readings; false if any failed
+static bool averagedRead(HdcBackend& backend, uint8_t n, double& temperature, double& humidity) {
+  double sumT = 0.0, sumRh = 0.0;
+  if (n == 0) n = 1;
+
+  for (uint8_t i = 0; i < n; i++) {
+    double t, rh;
+    if (!backend.readTemperatureHumidity(t, rh)) return false;
+    sumT += t;
+    sumRh += rh;
+  }
+  temperature = sumT / n;
+  humidity = sumRh / n;
+  return true;
+}
+
+bool maintenanceTriage(HdcBackend& backend, const TriageParams& params,
+                       MaintenanceObserver& observer, MaintenanceResult& result,
+                       TriageResult& triage) {
+  const MaintenanceOperation op = MAINT_OP_TRIAGE;
+  unsigned long opStart = backend.millis();
+  double initialTemp, initialHumidity;
+
+  result.success = false;
+  result.finalTemp = 0.0;
+  result.finalHumidity = 0.0;
+  result.tempOffset = 0.0;
+  result.humidityOffset = 0.0;
+  result.durationMs = 0;
+  result.failure = NULL;
+  triage.verdict = TRIAGE_OK;
+  triage.humidityError = 0.0;
+  triage.expectedHumidity = 0.0;
+  triage.pulseHumidity = 0.0;
+  triage.pulseRise = 0.0;
+
+  // Step 1: Ambient reference
+  backend.setMeasureMode(params.modes.baseline);
+  if (!averagedRead(backend, params.averageReads, initialTemp, initialHumidity)) {
+    return fail(observer, result, "Failed to read initial conditions");
+  }
+  report(observer, op, MAINT_EVT_INITIAL, initialTemp, initialHumidity, 0, 0);
+
+  // Step 2: Heat pulse, bounded by rise and time
+  if (!backend.heaterEnable(params.heaterPower)) {
+    return fail(observer, result, "Failed to enable heater");
+  }
+  observer.onMessage(heaterEnabledMessage(params.heaterPower));
+
+  double currentTemp = initialTemp;
+  double currentHumidity = initialHumidity;
+  unsigned long startTime = backend.millis();
+
+  observer.onProgress("QUICK TRIAGE", "Heat pulse...", initialTemp, initialHumidity, 0, 0);
+  backend.setMeasureMode(params.modes.ramp);
+
+  while (backend.millis() - startTime < params.pulseTimeoutMs) {
+    backend.delay(params.pollIntervalMs);
+
+    if (!backend.readTemperatureHumidity(currentTemp, currentHumidity)) {
+      observer.onMessage("Failed to read sensor during heating");
+      continue;
+    }
+
+    float heatRise = currentTemp - initialTemp;
+    unsigned long elapsedMs = backend.millis() - startTime;
+    report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, heatRise, elapsedMs);
+    observer.onProgress("QUICK TRIAGE", "Heat pulse...", currentTemp, currentHumidity, heatRise, elapsedMs / 1000);
+
+    if (heatRise >= params.pulseRise) break;
+  }
+
+  // Step 3: End-of-pulse reference, still heating
+  backend.setMeasureMode(params.modes.plateau);
+  double pulseTemp, pulseHumidity;
+  bool pulseOk = averagedRead(backend, params.averageReads, pulseTemp, pulseHumidity);
+
+  backend.heaterEnable(HDC_HEATER_OFF);
+  observer.onMessage("Heater disabled");
+
+  // Step 4: Compare with the curve for the measured ambient
+  bool classified = false;
+  if (!pulseOk) {
+    fail(observer, result, "Failed to read sensor at end of pulse");
+  } else {
+    double k = saturationRatio(initialTemp, pulseTemp);
+    triage.pulseRise = pulseTemp - initialTemp;
+    triage.pulseHumidity = pulseHumidity;
+
+    if (1.0 - k < TRIAGE_MIN_CONTRAST) {
+      fail(observer, result, "Heat pulse too small to tell");
+    } else {
+      triage.humidityError = (pulseHumidity - k * initialHumidity) / (1.0 - k);
+      triage.expectedHumidity = k * initialHumidity;  // If the part had no error
+
+      if (initialHumidity >= params.saturatedHumidity ||
+          triage.humidityError > params.condensationThreshold) {
+        triage.verdict = TRIAGE_NEEDS_CONDENSATION_REMOVAL;
+      } else if (fabs(triage.humidityError) > params.offsetThreshold) {
+        triage.verdict = TRIAGE_NEEDS_OFFSET_CORRECTION;
+      }
+      report(observer, op, MAINT_EVT_TRIAGE, pulseTemp, triage.humidityError, triage.pulseRise,
+             backend.millis() - startTime);
+      char message[40];
+      snprintf(message, sizeof(message), "Triage: %s", triageVerdictName(triage.verdict));
+      observer.onMessage(message);
+      classified = true;
+    }
+  }
+
+  // Step 5: Cooldown
+  observer.onMessage("Cooling down...");
+  observer.onProgress("QUICK TRIAGE", "Cooling...", currentTemp, currentHumidity, 0, 0);
+  backend.delay(params.cooldownMs);
+
+  backend.readTemperatureHumidity(result.finalTemp, result.finalHumidity);
+  result.durationMs = backend.millis() - opStart;
+  report(observer, op, MAINT_EVT_FINAL, result.finalTemp, result.finalHumidity, 0, result.durationMs);
+
+  result.success = classified;
+  return classified;
+}
+
+// ============================================================================
+// RECIPES
+// ============================================================================
+
+bool maintenanceRunRecipe(HdcBackend& backend, const Recipe& recipe,
+                          MaintenanceObserver& observer, MaintenanceResult& result) {
+  const MaintenanceOperation op = recipe.operation;
+  const char* title = recipe.name;
+  unsigned long opStart = backend.millis();
+  double initialTemp, initialHumidity;
+
+  result.success = false;
+  result.finalTemp = 0.0;
+  result.finalHumidity = 0.0;
+  result.tempOffset = 0.0;
+  result.humidityOffset = 0.0;
+  result.durationMs = 0;
+  result.failure = NULL;
+
+  // Initial conditions: rise reference and LUT lookup
+  backend.setMeasureMode(recipe.baselineMode);
+  if (!backend.readTemperatureHumidity(initialTemp, initialHumidity)) {
+    return fail(observer, result, "Failed to read initial conditions");
+  }
+  report(observer, op, MAINT_EVT_INITIAL, initialTemp, initialHumidity, 0, 0);
+
+  float lutRise = offsetTargetRise(OFFSET_RISE_LUT, initialTemp, initialHumidity);
+  for (uint8_t i = 0; i < recipe.stepCount; i++) {
+    if (recipe.steps[i].op == RECIPE_MONITOR && recipe.steps[i].arg == RECIPE_UNTIL_LUT_RISE) {
+      report(observer, op, MAINT_EVT_TARGET_RISE, initialTemp, initialHumidity, lutRise, 0);
+      break;
+    }
+  }
+
+  double currentTemp = initialTemp;
+  double currentHumidity = initialHumidity;
+  bool heaterOn = false;
+  bool failed = false;
+  bool offsetWritten = false;
+
+  for (uint8_t i = 0; i < recipe.stepCount; i++) {
+    const RecipeStep& step = recipe.steps[i];
+
+    // After a failure only the cooldowns still run
+    if (failed && step.op != RECIPE_COOLDOWN) continue;
+
+    switch (step.op) {
+      case RECIPE_HEAT: {
+        HdcHeaterPower power = recipeHeaterPower(step.arg);
+        if (!backend.heaterEnable(power)) {
+          fail(observer, result, "Failed to enable heater");
+          failed = true;
+          break;
+        }
+        heaterOn = power != HDC_HEATER_OFF;
+        observer.onMessage(heaterOn ? heaterEnabledMessage(power) : "Heater disabled");
+        break;
+      }
+
+      case RECIPE_MONITOR: {
+        bool untilDry = step.arg == RECIPE_UNTIL_RH_BELOW;
+        float target = step.value / 100.0f;
+        if (step.arg == RECIPE_UNTIL_LUT_RISE) target += lutRise;
+
+        char status[20];
+        if (untilDry) {
+          snprintf(status, sizeof(status), "Heating...");
+        } else {
+          snprintf(status, sizeof(status), "Target:+%dC", (int)(target + 0.5f));
+        }
+
+        unsigned long startTime = backend.millis();
+        unsigned long timeoutMs = step.limitSec * 1000UL;
+        bool reached = false;
+
+        observer.onProgress(title, status, currentTemp, currentHumidity, currentTemp - initialTemp, 0);
+        backend.setMeasureMode((HdcMeasureMode)step.mode);
+
+        while (backend.millis() - startTime < timeoutMs) {
+          backend.delay(step.pollMs);
+
+          if (!backend.readTemperatureHumidity(currentTemp, currentHumidity)) {
+            observer.onMessage("Failed to read sensor during heating");
+            continue;
+          }
+
+          float heatRise = currentTemp - initialTemp;
+          unsigned long elapsedMs = backend.millis() - startTime;
+          report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, heatRise, elapsedMs);
+          observer.onProgress(title, status, currentTemp, currentHumidity, heatRise, elapsedMs / 1000);
+
+          if (untilDry ? currentHumidity < target : heatRise >= target) {
+            observer.onMessage(untilDry ? "Humidity below threshold" : "Target temperature reached");
+            reached = true;
+            break;
+          }
+        }
+
+        if (!reached) {
+          observer.onMessage("WARNING: Timeout reached");
+          if (step.flags & RECIPE_FLAG_FAIL_ON_TIMEOUT) {
+            failed = true;
+            result.failure = "Timeout reached";
+          }
+        }
+        break;
+      }
+
+      case RECIPE_WRITE_OFFSET: {
+        // Sample at the top of the ramp, then heater off before the write
+        backend.setMeasureMode((HdcMeasureMode)step.mode);
+        double sampleTemp, sampleHumidity;
+        if (backend.readTemperatureHumidity(sampleTemp, sampleHumidity)) {
+          currentTemp = sampleTemp;
+          currentHumidity = sampleHumidity;
+          report(observer, op, MAINT_EVT_SAMPLE, currentTemp, currentHumidity, currentTemp - initialTemp,
+                 backend.millis() - opStart);
+        }
+
+        if (heaterOn) {
+          backend.heaterEnable(HDC_HEATER_OFF);
+          observer.onMessage("Heater disabled");
+          heaterOn = false;
+        }
+
+        result.humidityOffset = currentHumidity - step.value / 100.0;
+        report(observer, op, MAINT_EVT_OFFSET_CALCULATED, 0, result.humidityOffset, 0, 0);
+
+        if (!backend.writeOffsets(result.tempOffset, -result.humidityOffset)) {
+          fail(observer, result, "Failed to write offsets");
+          failed = true;
+          break;
+        }
+        observer.onMessage("Offsets written to sensor");
+        offsetWritten = true;
+
+        double verifyTemp, verifyHum;
+        if (backend.readOffsets(verifyTemp, verifyHum)) {
+          report(observer, op, MAINT_EVT_OFFSET_VERIFIED, verifyTemp, verifyHum, 0, 0);
+        }
+        break;
+      }
+
+      case RECIPE_COOLDOWN:
+        if (heaterOn) {
+          backend.heaterEnable(HDC_HEATER_OFF);
+          observer.onMessage("Heater disabled");
+          heaterOn = false;
+        }
+        observer.onMessage("Cooling down...");
+        observer.onProgress(title, "Cooling...", currentTemp, currentHumidity, 0, 0);
+        backend.delay(step.limitSec * 1000UL);
+        break;
+    }
+  }
+
+  // Validation requires a cooldown after heating; this is the backstop
+  if (heaterOn) {
+    backend.heaterEnable(HDC_HEATER_OFF);
+    observer.onMessage("Heater disabled");
+  }
+
+  backend.setMeasureMode(recipe.finalMode);
+  bool finalOk = backend.readTemperatureHumidity(result.finalTemp, result.finalHumidity);
+  result.durationMs = backend.millis() - opStart;
+  if (!offsetWritten) {
+    report(observer, op, MAINT_EVT_FINAL, result.finalTemp, result.finalHumidity, 0, result.durationMs);
+  } else if (finalOk) {
+    report(observer, op, MAINT_EVT_CORRECTED, result.finalTemp, result.finalHumidity, 0, 0);
+  }
+
+  result.success = !failed;
+  return result.success;
+}
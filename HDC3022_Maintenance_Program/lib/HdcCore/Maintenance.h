@@ -0,0 +1,192 @@
+#ifndef MAINTENANCE_H
+#define MAINTENANCE_H
+
+#include "HdcBackend.h"
+
+// ============================================================================
+// HDC MAINTENANCE ALGORITHMS
+// Portable versions of the condensation removal and offset error correction
+// procedures. They talk to the hardware only through HdcBackend and report
+// progress through MaintenanceObserver, so the firmware, the replay harness
+// and host tools all run exactly the same code.
+// ============================================================================
+
+// Look-Up Table for offset correction temperature rise
+// Rows: 10%..45% RH in 5% steps, Columns: 15..30C in 5C steps
+#define OFFSET_LUT_ROWS 8
+#define OFFSET_LUT_COLS 4
+extern const float OFFSET_RISE_LUT[OFFSET_LUT_ROWS][OFFSET_LUT_COLS];
+
+// Conversion mode for each phase of an operation
+struct MeasureModePolicy {
+  HdcMeasureMode baseline;  // Initial conditions (LUT lookup, rise reference)
+  HdcMeasureMode ramp;      // Readings while the heater is ramping
+  HdcMeasureMode plateau;   // Offset sample at the end of the ramp, post-cooldown readings
+};
+
+// Condensation removal tuning
+struct CondensationParams {
+  HdcHeaterPower heaterPower;
+  unsigned long pollIntervalMs;
+  unsigned long timeoutMs;
+  unsigned long cooldownMs;
+  double exitHumidity;        // Done when RH drops below this (%)
+  double almostDoneHumidity;  // Status changes to "Almost done!" below this (%)
+  MeasureModePolicy modes;
+};
+
+// Offset error correction tuning
+struct OffsetCorrectionParams {
+  HdcHeaterPower heaterPower;
+  unsigned long pollIntervalMs;
+  unsigned long timeoutMs;
+  unsigned long cooldownMs;
+  const float (*riseLut)[OFFSET_LUT_COLS];  // OFFSET_LUT_ROWS x OFFSET_LUT_COLS
+  MeasureModePolicy modes;
+};
+
+// Quick triage tuning: a short heat pulse instead of a full correction
+struct TriageParams {
+  HdcHeaterPower heaterPower;
+  unsigned long pollIntervalMs;
+  unsigned long pulseTimeoutMs;  // Heater is never on longer than this
+  double pulseRise;              // Heater off once the die is this far above ambient (C)
+  unsigned long cooldownMs;
+  uint8_t averageReads;          // Readings averaged before and at the end of the pulse
+  double offsetThreshold;        // |RH error| above this needs offset correction (%RH)
+  double condensationThreshold;  // RH error above this means condensate on the die (%RH)
+  double saturatedHumidity;      // Ambient reading at or above this means a wet die (%RH)
+  MeasureModePolicy modes;
+};
+
+// Defaults used by the firmware menu operations
+extern const CondensationParams DEFAULT_CONDENSATION_PARAMS;
+extern const OffsetCorrectionParams DEFAULT_OFFSET_PARAMS;
+extern const TriageParams DEFAULT_TRIAGE_PARAMS;
+
+// Progress events reported to the observer
+enum MaintenanceEvent {
+  MAINT_EVT_INITIAL = 0,       // temperature/humidity = initial conditions
+  MAINT_EVT_TARGET_RISE,       // rise = LUT target temperature rise
+  MAINT_EVT_SAMPLE,            // one heating-phase reading
+  MAINT_EVT_OFFSET_CALCULATED, // humidity = calculated humidity offset
+  MAINT_EVT_OFFSET_VERIFIED,   // temperature/humidity = offsets read back
+  MAINT_EVT_FINAL,             // temperature/humidity = post-cooldown reading
+  MAINT_EVT_CORRECTED,         // temperature/humidity = corrected reading
+  MAINT_EVT_TRIAGE,            // humidity = estimated RH error, rise = pulse rise
+  MAINT_EVT_TIME_SAVED         // elapsedMs = estimated time saved over separate runs
+};
+
+enum MaintenanceOperation {
+  MAINT_OP_CONDENSATION = 0,
+  MAINT_OP_OFFSET_CORRECTION,
+  MAINT_OP_TRIAGE,
+  MAINT_OP_COMBINED
+};
+
+#define MAINT_OP_COUNT 4
+
+struct MaintenanceReport {
+  MaintenanceOperation operation;
+  MaintenanceEvent event;
+  double temperature;
+  double humidity;
+  double rise;
+  unsigned long elapsedMs;
+};
+
+class MaintenanceObserver {
+public:
+  virtual ~MaintenanceObserver() {}
+
+  // Fixed diagnostic messages ("Heater disabled", "Cooling down...", ...)
+  virtual void onMessage(const char* message) {}
+  // Measurements and computed values
+  virtual void onReport(const MaintenanceReport& report) {}
+  // Screen update (title, status line, readings, rise, elapsed seconds)
+  virtual void onProgress(const char* title, const char* status, float temp,
+                          float humidity, float tempRise, int elapsedSec) {}
+};
+
+// Outcome of one operation
+struct MaintenanceResult {
+  bool success;
+  double finalTemp;
+  double finalHumidity;
+  double tempOffset;
+  double humidityOffset;
+  unsigned long durationMs;  // Start of operation through end of cooldown
+  const char* failure;       // Why it failed (as logged), NULL on success
+};
+
+// What a triage run says the part needs
+enum TriageVerdict {
+  TRIAGE_OK = 0,
+  TRIAGE_NEEDS_OFFSET_CORRECTION,
+  TRIAGE_NEEDS_CONDENSATION_REMOVAL
+};
+
+struct TriageResult {
+  TriageVerdict verdict;
+  double humidityError;     // Estimated RH reading error (%RH, reading - true)
+  double expectedHumidity;  // RH a part with no error would read at the end of the pulse
+  double pulseHumidity;     // What it did read
+  double pulseRise;         // C
+};
+
+// Target temperature rise for the given ambient conditions. Columns start at
+// 15, 20, 25, 30 C and rows at 10, 15 .. 45 %RH; anything outside the table
+// (including NaN) uses the nearest edge.
+float offsetTargetRise(const float (*lut)[OFFSET_LUT_COLS], double ambientTemp, double ambientHumidity);
+
+bool maintenanceCondensationRemoval(HdcBackend& backend, const CondensationParams& params,
+                                    MaintenanceObserver& observer, MaintenanceResult& result);
+bool maintenanceOffsetCorrection(HdcBackend& backend, const OffsetCorrectionParams& params,
+                                 MaintenanceObserver& observer, MaintenanceResult& result);
+
+// Quick triage. The vapour pressure at the die doesn't change during a short
+// heat pulse, so a sensor with an additive RH error e reads
+//   RH_pulse = k x (RH_ambient - e) + e,   k = es(T_ambient) / es(T_pulse)
+// Solving for e from the readings before and at the end of the pulse tells
+// whether the part needs offset correction. A condensate film pins RH at
+// 100 %: either the ambient reading is saturated, or the film outlasts the
+// pulse and e comes out large. Returns false if the readings failed or the
+// pulse was too small to tell (result.success likewise, result.failure says
+// which).
+bool maintenanceTriage(HdcBackend& backend, const TriageParams& params,
+                       MaintenanceObserver& observer, MaintenanceResult& result,
+                       TriageResult& triage);
+
+// "ok", "needs offset correction", "needs condensation removal"
+const char* triageVerdictName(TriageVerdict verdict);
+
+// Where the time went in a combined run (ms from heater on)
+struct CombinedResult {
+  unsigned long dryMs;     // RH fell below the exit threshold
+  unsigned long targetMs;  // Rise reached the LUT target (or the heater went off)
+  unsigned long savedMs;   // Estimated saving over the two operations in sequence
+};
+
+// Condensation removal and offset correction in one heat cycle: dry at the
+// condensation power, carry on to the offset target rise at the offset
+// power, sample, and cool down once. The target comes from the initial
+// reading, so a soaked part (reads saturated) uses the top LUT row. If the
+// rise passes the target while the part is still drying, there is no going
+// back: the offset is sampled at the dry point, above the target. The
+// saving is estimated as the skipped cooldown plus the reheat the offset
+// correction would have needed: min(targetMs, dryMs), scaled by the ratio of
+// heater powers. Fails without writing offsets if the part doesn't dry
+// within dry.timeoutMs; result.failure says why it failed.
+bool maintenanceCombined(HdcBackend& backend, const CondensationParams& dry,
+                         const OffsetCorrectionParams& offset, MaintenanceObserver& observer,
+                         MaintenanceResult& result, CombinedResult& combined);
+
+struct Recipe;  // Recipe.h
+
+// Run a data-defined procedure (Recipe.h) in place of the built-in one for
+// recipe.operation, reporting the same events. The recipe must pass
+// recipeValidate.
+bool maintenanceRunRecipe(HdcBackend& backend, const Recipe& recipe,
+                          MaintenanceObserver& observer, MaintenanceResult& result);
+
+#endif
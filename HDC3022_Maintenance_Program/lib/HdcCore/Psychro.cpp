@@ -0,0 +1,102 @@
+#include "Psychro.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// FAST LOG / EXP
+// ============================================================================
+
+static inline uint32_t floatBits(float f) {
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+static inline float bitsFloat(uint32_t u) {
+  float f;
+  memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+float fastLogf(float x) {
+  if (!(x > 0.0f)) return -INFINITY;
+
+  // x = m * 2^e with m in [sqrt(0.5), sqrt(2)) - offsetting the bits by
+  // sqrt(0.5) does the split without a data-dependent branch
+  uint32_t ix = floatBits(x) - 0x3F3504F3;
+  int e = (int32_t)ix >> 23;
+  float m = bitsFloat((ix & 0x007FFFFF) + 0x3F3504F3);
+
+  // ln(m) = 2 (s + s^3/3 + s^5/5 + s^7/7 + ...), s = (m - 1) / (m + 1), |s| < 0.172
+  float s = (m - 1.0f) / (m + 1.0f);
+  float s2 = s * s;
+  float series = s * (2.0f + s2 * (0.6666667f + s2 * (0.4f + s2 * 0.2857143f)));
+
+  return (float)e * 0.69314718f + series;
+}
+
+float fastExpf(float x) {
+  if (x < -87.0f) return 0.0f;
+  if (x > 88.0f) return INFINITY;
+
+  // e^x = 2^n * e^r, n = round(x / ln2), |r| <= ln2 / 2. Adding 1.5 * 2^23
+  // rounds to the nearest integer in the FPU, no branch on the sign.
+  float fn = (x * 1.44269504f + 12582912.0f) - 12582912.0f;
+  int n = (int)fn;
+  float r = x - fn * 0.69314718f;
+
+  // Taylor to r^6 (truncation < 1.2e-7 relative on |r| <= 0.347)
+  float p = 1.0f + r * (1.0f + r * (0.5f + r * (0.16666667f + r * (0.041666668f +
+            r * (0.008333334f + r * 0.0013888889f)))));
+
+  return p * bitsFloat((uint32_t)(n + 127) << 23);
+}
+
+// ============================================================================
+// METRICS
+// ============================================================================
+
+void computeDerivedMetrics(float temperature, float humidity, DerivedMetrics& out) {
+  if (humidity < PSYCHRO_MIN_RH) humidity = PSYCHRO_MIN_RH;
+  if (humidity > 100.0f) humidity = 100.0f;
+
+  // gamma = ln(e / e0) = ln(RH / 100) + a T / (b + T)
+  float gamma = fastLogf(humidity * 0.01f) +
+                PSYCHRO_MAGNUS_A * temperature / (PSYCHRO_MAGNUS_B + temperature);
+
+  out.dewPoint = PSYCHRO_MAGNUS_B * gamma / (PSYCHRO_MAGNUS_A - gamma);
+
+  // Vapour pressure e = e0 exp(gamma) hPa; AH = 216.7 e / T(K) g/m3
+  float vapour = PSYCHRO_MAGNUS_E0 * fastExpf(gamma);
+  out.absoluteHumidity = 216.7f * vapour / (temperature + 273.15f);
+
+  float margin = temperature - out.dewPoint;
+  out.margin = margin > 0.0f ? margin : 0.0f;
+}
+
+void computeDerivedMetricsBatch(const float* temperature, const float* humidity,
+                                DerivedMetrics* out, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    computeDerivedMetrics(temperature[i], humidity[i], out[i]);
+  }
+}
+
+double dewPointReference(double temperature, double humidity) {
+  if (humidity < PSYCHRO_MIN_RH) humidity = PSYCHRO_MIN_RH;
+  if (humidity > 100.0) humidity = 100.0;
+
+  double a = PSYCHRO_MAGNUS_A, b = PSYCHRO_MAGNUS_B;
+  double gamma = log(humidity / 100.0) + a * temperature / (b + temperature);
+  return b * gamma / (a - gamma);
+}
+
+double absoluteHumidityReference(double temperature, double humidity) {
+  if (humidity < PSYCHRO_MIN_RH) humidity = PSYCHRO_MIN_RH;
+  if (humidity > 100.0) humidity = 100.0;
+
+  double a = PSYCHRO_MAGNUS_A, b = PSYCHRO_MAGNUS_B;
+  double vapour = PSYCHRO_MAGNUS_E0 * humidity / 100.0 * exp(a * temperature / (b + temperature));
+  return 216.7 * vapour / (temperature + 273.15);
+}
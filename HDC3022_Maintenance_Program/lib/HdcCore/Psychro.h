@@ -0,0 +1,52 @@
+#ifndef PSYCHRO_H
+#define PSYCHRO_H
+
+#include <stddef.h>
+
+// ============================================================================
+// DERIVED HUMIDITY METRICS
+// Dew point, absolute humidity and margin to condensation from a T/RH
+// sample, using the Magnus formula over water (a = 17.62, b = 243.12 C,
+// 6.112 hPa - the same fit the simulator uses; valid -45..60 C).
+//
+// The fast versions are single precision (the SAMD51 FPU has no double
+// support, so libm log()/exp() on doubles run in software): ln() from the
+// float exponent plus an odd series in (m - 1) / (m + 1) on m in
+// [0.707, 1.414), exp() as 2^n x a degree-6 polynomial on |x| <= ln2 / 2.
+// Worst errors against the double-precision libm formulas, measured by
+// native_psychro over T = -40..85 C, RH = 1..100 % (0.05 steps):
+//   dew point          |error| < 0.0001 C
+//   absolute humidity  relative error < 2e-6
+//   margin             |error| < 0.0001 C
+//   fastLogf           |error| < 1e-6 (absolute, 1e-6..1e6)
+//   fastExpf           relative error < 5e-6 (-80..80; < 1e-6 for |x| < 10)
+// RH below PSYCHRO_MIN_RH is clamped (the dew point diverges at 0 %).
+// ============================================================================
+
+#define PSYCHRO_MAGNUS_A 17.62f
+#define PSYCHRO_MAGNUS_B 243.12f
+#define PSYCHRO_MAGNUS_E0 6.112f  // hPa
+#define PSYCHRO_MIN_RH 0.1f
+
+struct DerivedMetrics {
+  float dewPoint;          // C
+  float absoluteHumidity;  // g/m3
+  float margin;            // C above the dew point (0 = condensing)
+};
+
+// Single-precision ln / exp (bounds above)
+float fastLogf(float x);
+float fastExpf(float x);
+
+// One sample
+void computeDerivedMetrics(float temperature, float humidity, DerivedMetrics& out);
+
+// Many samples / sensors (arrays of n)
+void computeDerivedMetricsBatch(const float* temperature, const float* humidity,
+                                DerivedMetrics* out, size_t n);
+
+// Double-precision libm versions of the same formulas (tests, benchmarks)
+double dewPointReference(double temperature, double humidity);
+double absoluteHumidityReference(double temperature, double humidity);
+
+#endif
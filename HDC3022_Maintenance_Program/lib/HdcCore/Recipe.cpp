@@ -0,0 +1,344 @@
+#include "Recipe.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "LogCodec.h"
+
+const char* recipeStatusName(RecipeStatus status) {
+  switch (status) {
+    case RECIPE_OK:             return "ok";
+    case RECIPE_BAD_SIZE:       return "bad size";
+    case RECIPE_BAD_MAGIC:      return "not a recipe";
+    case RECIPE_BAD_VERSION:    return "unsupported version";
+    case RECIPE_BAD_CRC:        return "CRC mismatch";
+    case RECIPE_BAD_OPERATION:  return "operation has no recipe form";
+    case RECIPE_BAD_STEP:       return "invalid step";
+    case RECIPE_HEATER_LEFT_ON: return "no cooldown after heating";
+    case RECIPE_HEAT_TOO_LONG:  return "heater time over limit";
+    default:                    return "?";
+  }
+}
+
+HdcHeaterPower recipeHeaterPower(uint8_t level) {
+  switch (level) {
+    case RECIPE_HEATER_QUARTER: return HDC_HEATER_QUARTER_POWER;
+    case RECIPE_HEATER_HALF:    return HDC_HEATER_HALF_POWER;
+    case RECIPE_HEATER_FULL:    return HDC_HEATER_FULL_POWER;
+    default:                    return HDC_HEATER_OFF;
+  }
+}
+
+static uint8_t recipeHeaterLevel(HdcHeaterPower power) {
+  switch (power) {
+    case HDC_HEATER_QUARTER_POWER: return RECIPE_HEATER_QUARTER;
+    case HDC_HEATER_HALF_POWER:    return RECIPE_HEATER_HALF;
+    case HDC_HEATER_FULL_POWER:    return RECIPE_HEATER_FULL;
+    default:                       return RECIPE_HEATER_OFF;
+  }
+}
+
+// ============================================================================
+// VALIDATION
+// ============================================================================
+
+static bool stepValid(const RecipeStep& s) {
+  if (s.mode >= HDC_MODE_COUNT) return false;
+  switch (s.op) {
+    case RECIPE_HEAT:
+      return s.arg < RECIPE_HEATER_COUNT;
+    case RECIPE_MONITOR:
+      if (s.arg >= RECIPE_CONDITION_COUNT) return false;
+      if (s.pollMs == 0 || s.limitSec == 0) return false;
+      // RH threshold within 0..100 %, absolute rise positive
+      if (s.arg == RECIPE_UNTIL_RH_BELOW) return s.value > 0 && s.value <= 10000;
+      if (s.arg == RECIPE_UNTIL_RISE) return s.value > 0;
+      // LUT adjustment only upwards - below the table the part isn't heated
+      return s.value >= 0;
+    case RECIPE_COOLDOWN:
+      return s.limitSec <= RECIPE_MAX_COOLDOWN_S;
+    case RECIPE_WRITE_OFFSET:
+      return s.value >= 0 && s.value <= 10000;
+    default:
+      return false;
+  }
+}
+
+bool recipeOperationSupported(int operation) {
+  return operation == MAINT_OP_CONDENSATION || operation == MAINT_OP_OFFSET_CORRECTION ||
+         operation == MAINT_OP_COMBINED;
+}
+
+RecipeStatus recipeValidate(const Recipe& recipe, int* badStep) {
+  if (badStep != NULL) *badStep = -1;
+
+  if (!recipeOperationSupported(recipe.operation)) return RECIPE_BAD_OPERATION;
+  if (recipe.baselineMode >= HDC_MODE_COUNT || recipe.finalMode >= HDC_MODE_COUNT) {
+    return RECIPE_BAD_STEP;
+  }
+  if (recipe.stepCount == 0 || recipe.stepCount > RECIPE_MAX_STEPS) return RECIPE_BAD_SIZE;
+
+  bool heaterOn = false;
+  int lastHeat = -1;
+  unsigned long heatSec = 0;
+
+  for (int i = 0; i < recipe.stepCount; i++) {
+    const RecipeStep& s = recipe.steps[i];
+    if (!stepValid(s)) {
+      if (badStep != NULL) *badStep = i;
+      return RECIPE_BAD_STEP;
+    }
+
+    switch (s.op) {
+      case RECIPE_HEAT:
+        heaterOn = s.arg != RECIPE_HEATER_OFF;
+        if (heaterOn) lastHeat = i;
+        break;
+      case RECIPE_MONITOR:
+        if (heaterOn) heatSec += s.limitSec;
+        break;
+      case RECIPE_COOLDOWN:
+      case RECIPE_WRITE_OFFSET:
+        heaterOn = false;
+        break;
+    }
+    if (heatSec > RECIPE_MAX_HEAT_S) {
+      if (badStep != NULL) *badStep = i;
+      return RECIPE_HEAT_TOO_LONG;
+    }
+  }
+
+  // The final reading must not be taken on a hot die (cooldown 0 doesn't count)
+  if (lastHeat >= 0) {
+    bool cooled = false;
+    for (int i = lastHeat + 1; i < recipe.stepCount; i++) {
+      if (recipe.steps[i].op == RECIPE_COOLDOWN && recipe.steps[i].limitSec > 0) cooled = true;
+    }
+    if (!cooled) {
+      if (badStep != NULL) *badStep = lastHeat;
+      return RECIPE_HEATER_LEFT_ON;
+    }
+  }
+  return RECIPE_OK;
+}
+
+// ============================================================================
+// BINARY FORMAT
+// ============================================================================
+
+static void putU16(uint8_t* p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+static uint16_t getU16(const uint8_t* p) {
+  return p[0] | (uint16_t)p[1] << 8;
+}
+
+size_t recipeEncode(const Recipe& recipe, uint8_t* out) {
+  uint8_t count = recipe.stepCount <= RECIPE_MAX_STEPS ? recipe.stepCount : RECIPE_MAX_STEPS;
+
+  out[0] = RECIPE_MAGIC0;
+  out[1] = RECIPE_MAGIC1;
+  out[2] = RECIPE_VERSION;
+  out[3] = (uint8_t)recipe.operation;
+  out[4] = (uint8_t)recipe.baselineMode;
+  out[5] = (uint8_t)recipe.finalMode;
+  out[6] = count;
+  out[7] = 0;
+  size_t nameLen = strlen(recipe.name);
+  if (nameLen > RECIPE_NAME_LEN) nameLen = RECIPE_NAME_LEN;
+  memset(out + 8, 0, RECIPE_NAME_LEN);
+  memcpy(out + 8, recipe.name, nameLen);
+
+  uint8_t* p = out + RECIPE_HEADER_SIZE;
+  for (uint8_t i = 0; i < count; i++, p += RECIPE_STEP_SIZE) {
+    const RecipeStep& s = recipe.steps[i];
+    p[0] = s.op;
+    p[1] = s.arg;
+    p[2] = s.mode;
+    p[3] = s.flags;
+    putU16(p + 4, s.pollMs);
+    putU16(p + 6, s.limitSec);
+    putU16(p + 8, (uint16_t)s.value);
+    putU16(p + 10, 0);
+  }
+
+  uint32_t crc = logCrc32(0, out, p - out);
+  p[0] = crc & 0xFF;
+  p[1] = (crc >> 8) & 0xFF;
+  p[2] = (crc >> 16) & 0xFF;
+  p[3] = crc >> 24;
+  return p + RECIPE_CRC_SIZE - out;
+}
+
+RecipeStatus recipeDecode(const uint8_t* data, size_t len, Recipe& recipe) {
+  if (len < RECIPE_HEADER_SIZE + RECIPE_CRC_SIZE) return RECIPE_BAD_SIZE;
+  if (data[0] != RECIPE_MAGIC0 || data[1] != RECIPE_MAGIC1) return RECIPE_BAD_MAGIC;
+  if (data[2] != RECIPE_VERSION) return RECIPE_BAD_VERSION;
+
+  uint8_t count = data[6];
+  if (count == 0 || count > RECIPE_MAX_STEPS) return RECIPE_BAD_SIZE;
+  size_t body = RECIPE_HEADER_SIZE + (size_t)count * RECIPE_STEP_SIZE;
+  if (len != body + RECIPE_CRC_SIZE) return RECIPE_BAD_SIZE;
+
+  const uint8_t* c = data + body;
+  uint32_t stored = c[0] | (uint32_t)c[1] << 8 | (uint32_t)c[2] << 16 | (uint32_t)c[3] << 24;
+  if (logCrc32(0, data, body) != stored) return RECIPE_BAD_CRC;
+
+  memset(&recipe, 0, sizeof(recipe));
+  recipe.operation = (MaintenanceOperation)data[3];
+  recipe.baselineMode = (HdcMeasureMode)data[4];
+  recipe.finalMode = (HdcMeasureMode)data[5];
+  recipe.stepCount = count;
+  memcpy(recipe.name, data + 8, RECIPE_NAME_LEN);
+  recipe.name[RECIPE_NAME_LEN] = '\0';
+
+  const uint8_t* p = data + RECIPE_HEADER_SIZE;
+  for (uint8_t i = 0; i < count; i++, p += RECIPE_STEP_SIZE) {
+    RecipeStep& s = recipe.steps[i];
+    s.op = p[0];
+    s.arg = p[1];
+    s.mode = p[2];
+    s.flags = p[3];
+    s.pollMs = getU16(p + 4);
+    s.limitSec = getU16(p + 6);
+    s.value = (int16_t)getU16(p + 8);
+  }
+
+  return recipeValidate(recipe, NULL);
+}
+
+void recipeToHex(const uint8_t* data, size_t len, char* out) {
+  static const char DIGITS[] = "0123456789ABCDEF";
+  for (size_t i = 0; i < len; i++) {
+    *out++ = DIGITS[data[i] >> 4];
+    *out++ = DIGITS[data[i] & 0x0F];
+  }
+  *out = '\0';
+}
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+size_t recipeFromHex(const char* hex, uint8_t* out, size_t outMax) {
+  size_t n = 0;
+  while (hex[0] != '\0') {
+    if (hex[1] == '\0' || n >= outMax) return 0;
+    int hi = hexDigit(hex[0]);
+    int lo = hexDigit(hex[1]);
+    if (hi < 0 || lo < 0) return 0;
+    out[n++] = (uint8_t)(hi << 4 | lo);
+    hex += 2;
+  }
+  return n;
+}
+
+// ============================================================================
+// BUILT-IN PROCEDURES AS RECIPES
+// ============================================================================
+
+static int16_t hundredths(double value) {
+  return (int16_t)lround(value * 100.0);
+}
+
+static uint16_t seconds(unsigned long ms) {
+  return (uint16_t)((ms + 999) / 1000);
+}
+
+static RecipeStep makeStep(RecipeOp op, uint8_t arg, HdcMeasureMode mode) {
+  RecipeStep s;
+  memset(&s, 0, sizeof(s));
+  s.op = op;
+  s.arg = arg;
+  s.mode = mode;
+  return s;
+}
+
+void recipeFromCondensationParams(const CondensationParams& params, Recipe& recipe) {
+  memset(&recipe, 0, sizeof(recipe));
+  snprintf(recipe.name, sizeof(recipe.name), "CONDENSATION");
+  recipe.operation = MAINT_OP_CONDENSATION;
+  recipe.baselineMode = params.modes.baseline;
+  recipe.finalMode = params.modes.plateau;
+
+  RecipeStep* s = recipe.steps;
+  *s++ = makeStep(RECIPE_HEAT, recipeHeaterLevel(params.heaterPower), params.modes.ramp);
+
+  *s = makeStep(RECIPE_MONITOR, RECIPE_UNTIL_RH_BELOW, params.modes.ramp);
+  s->flags = RECIPE_FLAG_FAIL_ON_TIMEOUT;
+  s->pollMs = (uint16_t)params.pollIntervalMs;
+  s->limitSec = seconds(params.timeoutMs);
+  s->value = hundredths(params.exitHumidity);
+  s++;
+
+  *s = makeStep(RECIPE_COOLDOWN, 0, params.modes.plateau);
+  s->limitSec = seconds(params.cooldownMs);
+  s++;
+
+  recipe.stepCount = s - recipe.steps;
+}
+
+void recipeFromOffsetParams(const OffsetCorrectionParams& params, Recipe& recipe) {
+  memset(&recipe, 0, sizeof(recipe));
+  snprintf(recipe.name, sizeof(recipe.name), "OFFSET CORR.");
+  recipe.operation = MAINT_OP_OFFSET_CORRECTION;
+  recipe.baselineMode = params.modes.baseline;
+  recipe.finalMode = params.modes.plateau;
+
+  RecipeStep* s = recipe.steps;
+  *s++ = makeStep(RECIPE_HEAT, recipeHeaterLevel(params.heaterPower), params.modes.ramp);
+
+  *s = makeStep(RECIPE_MONITOR, RECIPE_UNTIL_LUT_RISE, params.modes.ramp);
+  s->pollMs = (uint16_t)params.pollIntervalMs;
+  s->limitSec = seconds(params.timeoutMs);
+  s++;
+
+  *s++ = makeStep(RECIPE_WRITE_OFFSET, 0, params.modes.plateau);
+
+  *s = makeStep(RECIPE_COOLDOWN, 0, params.modes.plateau);
+  s->limitSec = seconds(params.cooldownMs);
+  s++;
+
+  recipe.stepCount = s - recipe.steps;
+}
+
+void recipeFromCombinedParams(const CondensationParams& dry, const OffsetCorrectionParams& offset,
+                              Recipe& recipe) {
+  memset(&recipe, 0, sizeof(recipe));
+  snprintf(recipe.name, sizeof(recipe.name), "DRY+OFFSET");
+  recipe.operation = MAINT_OP_COMBINED;
+  recipe.baselineMode = dry.modes.baseline;
+  recipe.finalMode = offset.modes.plateau;
+
+  RecipeStep* s = recipe.steps;
+  *s++ = makeStep(RECIPE_HEAT, recipeHeaterLevel(dry.heaterPower), dry.modes.ramp);
+
+  *s = makeStep(RECIPE_MONITOR, RECIPE_UNTIL_RH_BELOW, dry.modes.ramp);
+  s->flags = RECIPE_FLAG_FAIL_ON_TIMEOUT;
+  s->pollMs = (uint16_t)dry.pollIntervalMs;
+  s->limitSec = seconds(dry.timeoutMs);
+  s->value = hundredths(dry.exitHumidity);
+  s++;
+
+  // No cooldown in between: straight on to the offset target
+  *s++ = makeStep(RECIPE_HEAT, recipeHeaterLevel(offset.heaterPower), offset.modes.ramp);
+
+  *s = makeStep(RECIPE_MONITOR, RECIPE_UNTIL_LUT_RISE, offset.modes.ramp);
+  s->pollMs = (uint16_t)offset.pollIntervalMs;
+  s->limitSec = seconds(offset.timeoutMs);
+  s++;
+
+  *s++ = makeStep(RECIPE_WRITE_OFFSET, 0, offset.modes.plateau);
+
+  *s = makeStep(RECIPE_COOLDOWN, 0, offset.modes.plateau);
+  s->limitSec = seconds(offset.cooldownMs);
+  s++;
+
+  recipe.stepCount = s - recipe.steps;
+}
@@ -0,0 +1,151 @@
+#ifndef RECIPE_H
+#define RECIPE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Maintenance.h"
+
+// ============================================================================
+// MAINTENANCE RECIPES
+// A maintenance procedure as data: a list of steps run by the interpreter
+// (maintenanceRunRecipe), so a station can be retuned by loading a recipe
+// over serial instead of reflashing it.
+//
+// Binary format, little-endian:
+//   header  20 bytes
+//     0  'H' 'R'
+//     2  version (RECIPE_VERSION)
+//     3  operation     MaintenanceOperation the recipe stands in for
+//     4  baseline mode HdcMeasureMode for the initial reading
+//     5  final mode    HdcMeasureMode for the post-cooldown reading
+//     6  step count    1..RECIPE_MAX_STEPS
+//     7  reserved (0)
+//     8  name          12 chars, NUL padded (screen title)
+//   steps   12 bytes each
+//     0  op            RecipeOp
+//     1  arg           HEAT: RecipeHeater, MONITOR: RecipeCondition
+//     2  mode          HdcMeasureMode for the step's readings
+//     3  flags         RECIPE_FLAG_*
+//     4  poll          MONITOR: ms between readings
+//     6  limit         MONITOR: timeout, COOLDOWN: duration (s)
+//     8  value         MONITOR: threshold, WRITE_OFFSET: target RH (1/100)
+//    10  reserved (0)
+//   CRC-32 of everything before it (logCrc32)
+//
+// Every run starts with a reading in the baseline mode (the reference for
+// rise conditions and the LUT) and ends with one in the final mode. The
+// heater is switched off at the end whatever the steps did.
+// ============================================================================
+
+#define RECIPE_MAGIC0 'H'
+#define RECIPE_MAGIC1 'R'
+#define RECIPE_VERSION 1
+#define RECIPE_NAME_LEN 12
+#define RECIPE_MAX_STEPS 16
+#define RECIPE_HEADER_SIZE 20
+#define RECIPE_STEP_SIZE 12
+#define RECIPE_CRC_SIZE 4
+#define RECIPE_MAX_SIZE (RECIPE_HEADER_SIZE + RECIPE_MAX_STEPS * RECIPE_STEP_SIZE + RECIPE_CRC_SIZE)
+
+// Longest the heater may be left on, counting every monitor timeout
+#define RECIPE_MAX_HEAT_S 600
+// Longest single cooldown. The station is silent meanwhile, and the fixture
+// gives up on a station after 60 s without output.
+#define RECIPE_MAX_COOLDOWN_S 45
+
+enum RecipeOp {
+  RECIPE_HEAT = 0,      // Switch the heater to arg (off allowed)
+  RECIPE_MONITOR,       // Poll until the condition holds or the timeout
+  RECIPE_COOLDOWN,      // Heater off, wait limit seconds
+  RECIPE_WRITE_OFFSET,  // Sample, heater off, write RH offset = reading - value, verify
+  RECIPE_OP_COUNT
+};
+
+// Heater levels (HdcHeaterPower values are register settings, too wide
+// for the step's arg byte)
+enum RecipeHeater {
+  RECIPE_HEATER_OFF = 0,
+  RECIPE_HEATER_QUARTER,
+  RECIPE_HEATER_HALF,
+  RECIPE_HEATER_FULL,
+  RECIPE_HEATER_COUNT
+};
+
+enum RecipeCondition {
+  RECIPE_UNTIL_RH_BELOW = 0,  // RH < value
+  RECIPE_UNTIL_RISE,          // Rise above the baseline >= value
+  RECIPE_UNTIL_LUT_RISE,      // Rise >= OFFSET_RISE_LUT target + value
+  RECIPE_CONDITION_COUNT
+};
+
+// MONITOR: a timeout fails the run - only the remaining cooldown steps
+// still run. Without the flag the run carries on with the next step.
+#define RECIPE_FLAG_FAIL_ON_TIMEOUT 0x01
+
+struct RecipeStep {
+  uint8_t op;
+  uint8_t arg;
+  uint8_t mode;
+  uint8_t flags;
+  uint16_t pollMs;
+  uint16_t limitSec;
+  int16_t value;  // Hundredths of %RH or C
+};
+
+struct Recipe {
+  char name[RECIPE_NAME_LEN + 1];
+  MaintenanceOperation operation;
+  HdcMeasureMode baselineMode;
+  HdcMeasureMode finalMode;
+  uint8_t stepCount;
+  RecipeStep steps[RECIPE_MAX_STEPS];
+};
+
+enum RecipeStatus {
+  RECIPE_OK = 0,
+  RECIPE_BAD_SIZE,
+  RECIPE_BAD_MAGIC,
+  RECIPE_BAD_VERSION,
+  RECIPE_BAD_CRC,
+  RECIPE_BAD_OPERATION,
+  RECIPE_BAD_STEP,
+  RECIPE_HEATER_LEFT_ON,  // No non-zero cooldown after the last heating step
+  RECIPE_HEAT_TOO_LONG    // Over RECIPE_MAX_HEAT_S
+};
+
+HdcHeaterPower recipeHeaterPower(uint8_t level);
+
+// "ok", "bad size", ...
+const char* recipeStatusName(RecipeStatus status);
+
+// Does the operation have a recipe form (triage doesn't)?
+bool recipeOperationSupported(int operation);
+
+// Can the interpreter run it safely? Checks field ranges (including the
+// cooldown limit and a non-negative LUT rise adjustment), the operation
+// (triage has no recipe form), that a cooldown follows the last heating
+// step and the heater time limit. Index of the offending step in *badStep
+// when not NULL.
+RecipeStatus recipeValidate(const Recipe& recipe, int* badStep);
+
+// Binary encoding. Returns bytes written (at most RECIPE_MAX_SIZE).
+size_t recipeEncode(const Recipe& recipe, uint8_t* out);
+// Inverse of recipeEncode, then recipeValidate.
+RecipeStatus recipeDecode(const uint8_t* data, size_t len, Recipe& recipe);
+
+// Hex for the serial RECIPE LOAD command. out must hold 2 * len + 1 chars.
+void recipeToHex(const uint8_t* data, size_t len, char* out);
+// Returns bytes decoded, 0 on an odd length, a bad digit or overflow.
+size_t recipeFromHex(const char* hex, uint8_t* out, size_t outMax);
+
+// The built-in procedures written as recipes - a starting point for tuning,
+// and a check that the interpreter matches them (native_recipe "builtin").
+void recipeFromCondensationParams(const CondensationParams& params, Recipe& recipe);
+void recipeFromOffsetParams(const OffsetCorrectionParams& params, Recipe& recipe);
+// Same steps as maintenanceCombined, except the LUT monitor always takes
+// one reading even when the part passed the target while drying
+void recipeFromCombinedParams(const CondensationParams& dry, const OffsetCorrectionParams& offset,
+                              Recipe& recipe);
+
+#endif
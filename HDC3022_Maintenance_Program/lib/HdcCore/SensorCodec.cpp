@@ -0,0 +1,31 @@
+#include "SensorCodec.h"
+
+uint64_t packNistId(const uint8_t* bytes) {
+  uint64_t id = 0;
+  for (int i = 0; i < HDC_NIST_ID_BYTES; i++) {
+    id = (id << 8) | bytes[i];
+  }
+  return id;
+}
+
+double hdcTemperatureFromCode(uint16_t code) {
+  return -45.0 + 175.0 * code / 65535.0;
+}
+
+double hdcHumidityFromCode(uint16_t code) {
+  return 100.0 * code / 65535.0;
+}
+
+static uint16_t codeFor(double scaled) {
+  if (!(scaled > 0.0)) return 0;  // Also NaN
+  if (scaled >= 65535.0) return 65535;
+  return (uint16_t)(scaled + 0.5);
+}
+
+uint16_t hdcTemperatureToCode(double temperature) {
+  return codeFor((temperature + 45.0) * 65535.0 / 175.0);
+}
+
+uint16_t hdcHumidityToCode(double humidity) {
+  return codeFor(humidity * 65535.0 / 100.0);
+}
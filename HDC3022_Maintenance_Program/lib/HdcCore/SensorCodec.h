@@ -0,0 +1,28 @@
+#ifndef SENSOR_CODEC_H
+#define SENSOR_CODEC_H
+
+#include <stdint.h>
+
+// ============================================================================
+// HDC302x DATA ENCODING
+// Conversions between the sensor's 16-bit codes / ID bytes and engineering
+// units (datasheet section 8.3):
+//   T  = -45 + 175 x code / 65535  (C)
+//   RH = 100 x code / 65535        (%RH)
+// The NIST ID is 6 bytes, most significant first, packed into the low 48
+// bits of a uint64_t (formatNistId() in TextFormat.h prints it).
+// ============================================================================
+
+#define HDC_NIST_ID_BYTES 6
+
+uint64_t packNistId(const uint8_t* bytes);
+
+double hdcTemperatureFromCode(uint16_t code);
+double hdcHumidityFromCode(uint16_t code);
+
+// Nearest code for a value, clamped to the sensor's range (-45..130 C,
+// 0..100 %RH; NaN gives code 0)
+uint16_t hdcTemperatureToCode(double temperature);
+uint16_t hdcHumidityToCode(double humidity);
+
+#endif
@@ -0,0 +1,83 @@
+#include "StationProtocol.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Capture.h"
+#include "TextFormat.h"
+
+void stationResultFrom(MaintenanceOperation operation, const MaintenanceResult& result,
+                       StationResult& out) {
+  out.operation = operation;
+  out.success = result.success;
+  out.durationMs = result.durationMs;
+  out.tempOffset = result.tempOffset;
+  out.humidityOffset = result.humidityOffset;
+  out.finalTemp = result.finalTemp;
+  out.finalHumidity = result.finalHumidity;
+  out.verdict = TRIAGE_OK;
+  out.savedMs = 0;
+}
+
+void stationResultFromTriage(const MaintenanceResult& result, const TriageResult& triage,
+                             StationResult& out) {
+  stationResultFrom(MAINT_OP_TRIAGE, result, out);
+  out.humidityOffset = triage.humidityError;
+  out.verdict = triage.verdict;
+}
+
+void stationResultFromCombined(const MaintenanceResult& result, const CombinedResult& combined,
+                               StationResult& out) {
+  stationResultFrom(MAINT_OP_COMBINED, result, out);
+  out.savedMs = combined.savedMs;
+}
+
+int formatStationId(uint64_t nistId, char* buf, size_t len) {
+  char hex[13];
+  formatNistId(hex, nistId);
+  return snprintf(buf, len, STATION_ID_PREFIX "%s", hex);
+}
+
+int formatStationResult(const StationResult& result, char* buf, size_t len) {
+  return snprintf(buf, len, STATION_RESULT_PREFIX "%d,%d,%lu,%ld,%ld,%ld,%ld,%d,%lu",
+                  (int)result.operation, result.success ? 1 : 0, result.durationMs,
+                  captureToMilli(result.tempOffset), captureToMilli(result.humidityOffset),
+                  captureToMilli(result.finalTemp), captureToMilli(result.finalHumidity),
+                  (int)result.verdict, result.savedMs);
+}
+
+bool parseStationId(const char* line, uint64_t& nistId) {
+  if (strncmp(line, STATION_ID_PREFIX, strlen(STATION_ID_PREFIX)) != 0) return false;
+
+  const char* hex = line + strlen(STATION_ID_PREFIX);
+  char* end;
+  unsigned long long value = strtoull(hex, &end, 16);
+  if (end - hex != 12) return false;
+
+  nistId = (uint64_t)value;
+  return true;
+}
+
+bool parseStationResult(const char* line, StationResult& result) {
+  if (strncmp(line, STATION_RESULT_PREFIX, strlen(STATION_RESULT_PREFIX)) != 0) return false;
+
+  int op, ok, verdict = TRIAGE_OK;
+  long tOff, rhOff, temp, rh;
+  unsigned long saved = 0;
+  int fields = sscanf(line, STATION_RESULT_PREFIX "%d,%d,%lu,%ld,%ld,%ld,%ld,%d,%lu",
+                      &op, &ok, &result.durationMs, &tOff, &rhOff, &temp, &rh, &verdict, &saved);
+  if (fields < 7) return false;  // <verdict> and <saved> are optional
+  if (op < 0 || op >= MAINT_OP_COUNT) return false;
+  if (verdict < TRIAGE_OK || verdict > TRIAGE_NEEDS_CONDENSATION_REMOVAL) return false;
+
+  result.operation = (MaintenanceOperation)op;
+  result.success = ok != 0;
+  result.tempOffset = captureFromMilli(tOff);
+  result.humidityOffset = captureFromMilli(rhOff);
+  result.finalTemp = captureFromMilli(temp);
+  result.finalHumidity = captureFromMilli(rh);
+  result.verdict = (TriageVerdict)verdict;
+  result.savedMs = saved;
+  return true;
+}
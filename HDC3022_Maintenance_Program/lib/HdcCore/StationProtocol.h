@@ -0,0 +1,75 @@
+#ifndef STATION_PROTOCOL_H
+#define STATION_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Maintenance.h"
+
+// ============================================================================
+// STATION PROTOCOL
+// Lets a host drive a maintenance station over its serial port.
+//
+// Host -> station, one command per line:
+//   ID           re-read the sensor's NIST ID and report it
+//   RUN COND     run condensation removal (no button press to finish)
+//   RUN OFFSET   run offset error correction
+//   RUN TRIAGE   quick heat-pulse triage
+//   RUN COMBINED condensation removal + offset correction in one heat cycle
+//
+// Station -> host, besides the normal log and the CAP lines (Capture.h)
+// that show an operation's progress:
+//   ID,<nist>
+//   RESULT,<op>,<ok>,<ms>,<tOff>,<rhOff>,<T>,<RH>,<verdict>,<saved>
+//
+//   <nist>   12 hex digits, 000000000000 when the ID can't be read
+//   <op>     0 condensation removal, 1 offset correction, 2 triage,
+//            3 combined
+//   <ok>     1 on success
+//   <ms>     operation duration
+//   <tOff>, <rhOff>  offsets calculated (mC, m%RH; 0 for condensation
+//                    removal). The sensor stores the RH offset negated.
+//                    For triage, <rhOff> is the estimated RH error.
+//   <T>, <RH>        final reading (mC, m%RH)
+//   <verdict>        triage verdict (TriageVerdict), 0 for other operations.
+//                    Lines without it (older firmware) parse as 0.
+//   <saved>          combined: estimated ms saved over separate runs, 0 for
+//                    other operations. Lines without it (older firmware)
+//                    parse as 0.
+//
+// RESULT is sent for every operation, including ones started from the
+// buttons, so the host can record those too.
+// ============================================================================
+
+#define STATION_ID_PREFIX "ID,"
+#define STATION_RESULT_PREFIX "RESULT,"
+#define STATION_LINE_MAX 96
+
+struct StationResult {
+  MaintenanceOperation operation;
+  bool success;
+  unsigned long durationMs;
+  double tempOffset;
+  double humidityOffset;
+  double finalTemp;
+  double finalHumidity;
+  TriageVerdict verdict;
+  unsigned long savedMs;
+};
+
+void stationResultFrom(MaintenanceOperation operation, const MaintenanceResult& result,
+                       StationResult& out);
+void stationResultFromTriage(const MaintenanceResult& result, const TriageResult& triage,
+                             StationResult& out);
+void stationResultFromCombined(const MaintenanceResult& result, const CombinedResult& combined,
+                               StationResult& out);
+
+// Format into buf (no newline). Return the line length.
+int formatStationId(uint64_t nistId, char* buf, size_t len);
+int formatStationResult(const StationResult& result, char* buf, size_t len);
+
+// Parse a station line. Return false for any other line.
+bool parseStationId(const char* line, uint64_t& nistId);
+bool parseStationResult(const char* line, StationResult& result);
+
+#endif
@@ -0,0 +1,79 @@
+#include "TextFormat.h"
+
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+void formatNistId(char* buf, uint64_t nistId) {
+  // Most significant nibble of the 48-bit ID first
+  for (int i = 0; i < 12; i++) {
+    buf[i] = HEX_DIGITS[(nistId >> (44 - 4 * i)) & 0x0F];
+  }
+  buf[12] = '\0';
+}
+
+size_t formatUnsigned(char* buf, size_t len, unsigned long value) {
+  if (len == 0) return 0;
+
+  char digits[10];
+  size_t n = 0;
+  do {
+    digits[n++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+
+  size_t pos = 0;
+  while (n > 0 && pos < len - 1) {
+    buf[pos++] = digits[--n];
+  }
+  buf[pos] = '\0';
+  return pos;
+}
+
+size_t formatFixed(char* buf, size_t len, double value, uint8_t decimals) {
+  if (len == 0) return 0;
+  if (decimals > 6) decimals = 6;
+
+  size_t pos = 0;
+  if (value < 0.0) {
+    if (pos < len - 1) buf[pos++] = '-';
+    value = -value;
+  }
+
+  unsigned long scale = 1;
+  for (uint8_t i = 0; i < decimals; i++) scale *= 10;
+
+  // Round once at the last digit, then split integer / fraction
+  double scaled = value * scale + 0.5;
+  if (scaled > 4294967295.0) scaled = 4294967295.0;
+  unsigned long fixed = (unsigned long)scaled;
+  unsigned long whole = fixed / scale;
+  unsigned long frac = fixed % scale;
+
+  pos += formatUnsigned(buf + pos, len - pos, whole);
+
+  if (decimals > 0 && pos < len - 1) {
+    buf[pos++] = '.';
+    for (unsigned long div = scale / 10; div > 0 && pos < len - 1; div /= 10) {
+      buf[pos++] = (char)('0' + (frac / div) % 10);
+    }
+  }
+  buf[pos] = '\0';
+  return pos;
+}
+
+size_t appendText(char* buf, size_t len, size_t pos, const char* text) {
+  while (*text != '\0' && pos + 1 < len) {
+    buf[pos++] = *text++;
+  }
+  if (pos < len) buf[pos] = '\0';
+  return pos;
+}
+
+size_t appendFixed(char* buf, size_t len, size_t pos, double value, uint8_t decimals) {
+  if (pos >= len) return pos;
+  return pos + formatFixed(buf + pos, len - pos, value, decimals);
+}
+
+size_t appendUnsigned(char* buf, size_t len, size_t pos, unsigned long value) {
+  if (pos >= len) return pos;
+  return pos + formatUnsigned(buf + pos, len - pos, value);
+}
@@ -0,0 +1,30 @@
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// TEXT FORMATTING
+// Small allocation-free formatters for screen fields. The SAMD core's
+// printf has no float support, so fixed-point values are formatted here
+// (same rounding as Print::print(double, digits)).
+// ============================================================================
+
+// NIST ID as 12 upper-case hex digits (48 bits). buf must hold 13 bytes.
+void formatNistId(char* buf, uint64_t nistId);
+
+// Fixed-point value, e.g. formatFixed(buf, 8, -2.456, 2) -> "-2.46".
+// Returns the string length; output is truncated to len - 1 characters.
+size_t formatFixed(char* buf, size_t len, double value, uint8_t decimals);
+
+// Unsigned decimal. Returns the string length.
+size_t formatUnsigned(char* buf, size_t len, unsigned long value);
+
+// Append helpers: write at buf + pos, return the new position (always
+// NUL-terminated, never past len - 1)
+size_t appendText(char* buf, size_t len, size_t pos, const char* text);
+size_t appendFixed(char* buf, size_t len, size_t pos, double value, uint8_t decimals);
+size_t appendUnsigned(char* buf, size_t len, size_t pos, unsigned long value);
+
+#endif
@@ -0,0 +1,38 @@
+#include "TraceCodec.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* const TRACE_EVENT_NAMES[TRACE_EVT_COUNT] = {
+  "task", "sensor read", "display flush", "log write",
+  "operation", "serial command", "button", "heater"
+};
+
+const char* traceEventName(uint8_t id) {
+  return id < TRACE_EVT_COUNT ? TRACE_EVENT_NAMES[id] : "?";
+}
+
+int formatTraceEvent(const TraceEvent& event, char* buf, size_t len) {
+  return snprintf(buf, len, TRACE_LINE_PREFIX "%lu,%c,%u,%u",
+                  (unsigned long)event.timeUs, (char)event.phase,
+                  (unsigned)event.id, (unsigned)event.arg);
+}
+
+bool parseTraceEvent(const char* line, TraceEvent& event) {
+  if (strncmp(line, TRACE_LINE_PREFIX, strlen(TRACE_LINE_PREFIX)) != 0) return false;
+
+  unsigned long timeUs;
+  char phase;
+  unsigned id, arg;
+  if (sscanf(line, TRACE_LINE_PREFIX "%lu,%c,%u,%u", &timeUs, &phase, &id, &arg) != 4) {
+    return false;
+  }
+  if (phase != TRACE_BEGIN && phase != TRACE_END && phase != TRACE_INSTANT) return false;
+  if (id > 0xFF || arg > 0xFFFF) return false;
+
+  event.timeUs = (uint32_t)timeUs;
+  event.phase = (uint8_t)phase;
+  event.id = (uint8_t)id;
+  event.arg = (uint16_t)arg;
+  return true;
+}
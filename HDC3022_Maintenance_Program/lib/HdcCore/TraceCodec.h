@@ -0,0 +1,59 @@
+#ifndef TRACE_CODEC_H
+#define TRACE_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// TRACE EVENTS
+// Shared by the firmware's trace recorder (src/Trace.h) and the host
+// converter to Chrome / Perfetto JSON (src/host/trace_convert_main.cpp).
+//
+// In RAM an event is 8 bytes: micros() timestamp, phase, event id and a
+// 16-bit argument. The TRACE serial command dumps the buffer as text:
+//
+//   TRACE <events> <dropped>        header; dropped = overwritten events
+//   TRACE TASK <arg> <name>         scheduler task names, for TRACE_EVT_TASK
+//   TRACE,<us>,<phase>,<id>,<arg>   one event, oldest first
+//   TRACE END
+//
+//   <phase>  B begin, E end, I instant
+// ============================================================================
+
+enum TracePhase {
+  TRACE_BEGIN = 'B',
+  TRACE_END = 'E',
+  TRACE_INSTANT = 'I'
+};
+
+enum TraceEventId {
+  TRACE_EVT_TASK = 0,       // Scheduler task run, arg = task id
+  TRACE_EVT_SENSOR_READ,    // HDC302x read (conversion + I2C), arg = measure slot
+  TRACE_EVT_DISPLAY_FLUSH,  // OLED frame transfer over I2C
+  TRACE_EVT_LOG_WRITE,      // Sample log append to QSPI flash, arg = 1 with sector erase
+  TRACE_EVT_OPERATION,      // Maintenance operation, arg = MaintenanceOperation
+  TRACE_EVT_SERIAL_COMMAND, // Serial command handling
+  TRACE_EVT_BUTTON,         // Instant: button press, arg = 0 A, 1 B, 2 C
+  TRACE_EVT_HEATER,         // Instant: heater command, arg = HdcHeaterPower (0 = off)
+  TRACE_EVT_COUNT
+};
+
+struct TraceEvent {
+  uint32_t timeUs;
+  uint8_t phase;
+  uint8_t id;
+  uint16_t arg;
+};
+
+#define TRACE_LINE_PREFIX "TRACE,"
+#define TRACE_LINE_MAX 40
+
+// "task", "sensor read", ... ("?" for an unknown id)
+const char* traceEventName(uint8_t id);
+
+// Format an event line into buf (no newline). Returns the line length.
+int formatTraceEvent(const TraceEvent& event, char* buf, size_t len);
+// Parse an event line. Returns false for any other line.
+bool parseTraceEvent(const char* line, TraceEvent& event);
+
+#endif
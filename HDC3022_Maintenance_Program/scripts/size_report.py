@@ -0,0 +1,167 @@
+# ============================================================================
+# SIZE REPORT
+# PlatformIO post-build script: links with a map file and prints flash / RAM
+# per module from it - each source file of this project (src/, lib/) and
+# each library or framework archive as a whole. Also written to
+# size_report.csv in the build directory. Merged string constants are
+# counted at their size before merging, so the total can come out slightly
+# above what the ELF really holds.
+#
+#   [env:...]
+#   extra_scripts = post:scripts/size_report.py
+#
+# Standalone: python scripts/size_report.py .pio/build/<env>/firmware.map
+# ============================================================================
+
+import os
+import re
+import sys
+
+# Output sections are placed by their run address; those with a load
+# address in flash and a run address in RAM (.data) count for both
+SECTION_RE = re.compile(r"^(\.\S+|COMMON)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(.*)$")
+REGION_RE = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+
+
+def parse_regions(lines):
+    """Memory Configuration table -> [(name, origin, length)]"""
+    regions = []
+    inside = False
+    for line in lines:
+        if line.startswith("Memory Configuration"):
+            inside = True
+            continue
+        if inside and line.startswith("Linker script and memory map"):
+            break
+        m = REGION_RE.match(line) if inside else None
+        if m and m.group(1) != "*default*":
+            regions.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+    return regions
+
+
+def region_of(regions, address):
+    for name, origin, length in regions:
+        if origin <= address < origin + length:
+            return name
+    return None
+
+
+def module_name(path, project_libs):
+    path = path.strip().replace("\\", "/")
+    m = re.match(r"^(.*)\((.*)\)$", path)
+    if m:
+        archive = os.path.basename(m.group(1))
+        member = m.group(2)
+        name = re.sub(r"^lib|\.a$", "", archive)
+        if name in project_libs:
+            return "lib/%s/%s" % (name, re.sub(r"\.o$", "", member))
+        return name
+    if "/src/" in "/" + path:
+        return "src/" + re.sub(r"\.o$", "", ("/" + path).split("/src/", 1)[1])
+    return re.sub(r"\.o$", "", os.path.basename(path))
+
+
+def size_report(map_path, project_libs=(), out=sys.stdout, csv_path=None):
+    with open(map_path) as f:
+        lines = f.read().splitlines()
+
+    regions = parse_regions(lines)
+    flash_regions = [r for r in regions if "FLASH" in r[0].upper() or "ROM" in r[0].upper()]
+    ram_regions = [r for r in regions if "RAM" in r[0].upper()]
+
+    modules = {}
+    start = next((i for i, l in enumerate(lines) if l.startswith("Linker script and memory map")), 0)
+    in_flash = in_ram = False
+    pending = None  # Input section name wrapped onto its own line
+
+    for line in lines[start + 1:]:
+        # Output section: name in column 0
+        if line.startswith("."):
+            fields = line.split()
+            in_flash = in_ram = False
+            if len(fields) >= 3 and fields[1].startswith("0x"):
+                address = int(fields[1], 16)
+                in_ram = region_of(ram_regions, address) is not None
+                # NOLOAD sections can show a load address too - they take no flash
+                loaded = "load address" in line and not re.match(r"^\.(bss|heap|stack|noinit)", fields[0])
+                in_flash = region_of(flash_regions, address) is not None or loaded
+            elif len(fields) == 1:
+                pending = None
+            continue
+
+        # Input section: " .text.foo  0xaddr  0xsize  object"
+        if not line.startswith(" "):
+            continue
+        stripped = line.strip()
+        if stripped.startswith("*fill*"):
+            fields = stripped.split()
+            if len(fields) >= 3 and (in_flash or in_ram):
+                entry = modules.setdefault("(alignment)", [0, 0])
+                entry[0] += int(fields[2], 16) if in_flash else 0
+                entry[1] += int(fields[2], 16) if in_ram else 0
+            continue
+        if stripped.startswith("*"):
+            continue
+        if re.match(r"^(\.\S+|COMMON)$", stripped):
+            pending = stripped
+            continue
+        m = SECTION_RE.match(line.lstrip() if pending is None else pending + " " + line.lstrip())
+        pending = None
+        if not m or not m.group(1) or not m.group(4).strip():
+            continue
+        size = int(m.group(3), 16)
+        if size == 0 or not (in_flash or in_ram):
+            continue
+
+        entry = modules.setdefault(module_name(m.group(4), project_libs), [0, 0])
+        if in_flash:
+            entry[0] += size
+        if in_ram:
+            entry[1] += size
+
+    rows = sorted(modules.items(), key=lambda kv: -(kv[1][0] + kv[1][1]))
+    total_flash = sum(v[0] for _, v in rows)
+    total_ram = sum(v[1] for _, v in rows)
+
+    width = max([len(k) for k, _ in rows] + [6])
+    out.write("\nSize report (%s)\n" % map_path)
+    out.write("%-*s %8s %8s\n" % (width, "module", "flash", "ram"))
+    for name, (flash, ram) in rows:
+        out.write("%-*s %8d %8d\n" % (width, name, flash, ram))
+    out.write("%-*s %8d %8d\n" % (width, "total", total_flash, total_ram))
+    for name, origin, length in flash_regions + ram_regions:
+        used = total_ram if (name, origin, length) in ram_regions else total_flash
+        out.write("%s: %d of %d bytes (%.1f%%)\n" % (name, used, length, 100.0 * used / length))
+    out.write("RAM above does not include the heap and stack (see the MEM command)\n")
+
+    if csv_path:
+        with open(csv_path, "w") as f:
+            f.write("module,flash,ram\n")
+            for name, (flash, ram) in rows:
+                f.write('"%s",%d,%d\n' % (name, flash, ram))
+
+
+def project_lib_names(project_dir):
+    lib_dir = os.path.join(project_dir, "lib")
+    if not os.path.isdir(lib_dir):
+        return ()
+    return tuple(d for d in os.listdir(lib_dir) if os.path.isdir(os.path.join(lib_dir, d)))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        sys.stderr.write("usage: size_report.py firmware.map\n")
+        sys.exit(2)
+    here = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    size_report(sys.argv[1], project_lib_names(here))
+else:
+    Import("env")  # noqa: F821 (SCons)
+
+    map_path = os.path.join(env.subst("$BUILD_DIR"), env.subst("${PROGNAME}.map"))  # noqa: F821
+    env.Append(LINKFLAGS=["-Wl,-Map," + map_path])  # noqa: F821
+
+    def report(source, target, env):
+        size_report(map_path, project_lib_names(env.subst("$PROJECT_DIR")),
+                    csv_path=os.path.join(env.subst("$BUILD_DIR"), "size_report.csv"))
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", report)  # noqa: F821
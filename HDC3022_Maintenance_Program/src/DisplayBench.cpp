@@ -0,0 +1,221 @@
+#include "DisplayBench.h"
+#include "Screens.h"
+
+// ============================================================================
+// CYCLE COUNTER
+// DWT CYCCNT on Cortex-M4; micros() scaled by the clock elsewhere.
+// ============================================================================
+
+static void cycleCounterBegin() {
+#if defined(DWT)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+static inline uint32_t cycleCount() {
+#if defined(DWT)
+  return DWT->CYCCNT;
+#else
+  return micros() * (F_CPU / 1000000UL);
+#endif
+}
+
+// ============================================================================
+// PREVIOUS RENDERERS
+// Verbatim from before the field layer: clear and print every line.
+// ============================================================================
+
+static void legacyMainMenu(FieldDisplay& d, uint8_t selection, const SensorInfo& s) {
+  d.clearDisplay();
+  d.setTextSize(1);
+  d.setCursor(0, 0);
+
+  d.println("=== MAIN MENU ===");
+  d.println();
+
+  const char* menuItems[] = {
+    "1.View Sensor Info",
+    "2.Condensation Rem.",
+    "3.Offset Correction",
+    "4.Reset Offsets",
+    "5.Diagnostics"
+  };
+
+  // The menu as it was, whatever MAIN_MENU_ITEMS has grown to since
+  for (uint8_t i = 0; i < sizeof(menuItems) / sizeof(menuItems[0]); i++) {
+    d.print(i == selection ? "> " : "  ");
+    d.println(menuItems[i]);
+  }
+
+  d.setCursor(0, 56);
+  d.print("T:");
+  d.print(s.temperature, 1);
+  d.print("C RH:");
+  d.print(s.humidity, 1);
+  d.print("%");
+}
+
+static void legacySensorInfo(FieldDisplay& d, const SensorInfo& s) {
+  d.clearDisplay();
+  d.setTextSize(1);
+  d.setCursor(0, 0);
+
+  d.println("SENSOR INFO");
+  d.println("------------");
+
+  d.print("ID:");
+  char nistStr[13];
+  sprintf(nistStr, "%02X%02X%02X%02X%02X%02X",
+          (uint8_t)((s.nist_id >> 40) & 0xFF),
+          (uint8_t)((s.nist_id >> 32) & 0xFF),
+          (uint8_t)((s.nist_id >> 24) & 0xFF),
+          (uint8_t)((s.nist_id >> 16) & 0xFF),
+          (uint8_t)((s.nist_id >> 8) & 0xFF),
+          (uint8_t)(s.nist_id & 0xFF));
+  d.println(nistStr);
+
+  d.print("Temp: ");
+  d.print(s.temperature, 1);
+  d.println("C");
+
+  d.print("RH:   ");
+  d.print(s.humidity, 1);
+  d.println("%");
+
+  d.println("Offsets:");
+  d.print(" T:");
+  d.print(s.temp_offset, 2);
+  d.print(" RH:");
+  d.println(s.humidity_offset, 2);
+
+  d.setCursor(0, 56);
+  d.print("Press C to exit");
+}
+
+static void legacyOperation(FieldDisplay& d, const char* title, const char* status,
+                            float temp, float humidity, float tempRise, int elapsedSec) {
+  d.clearDisplay();
+  d.setTextSize(1);
+  d.setCursor(0, 0);
+
+  d.println(title);
+  d.println("------------");
+
+  d.print("T:");
+  d.print(temp, 1);
+  d.print("C");
+  if (tempRise > 0) {
+    d.print(" (+");
+    d.print(tempRise, 1);
+    d.print(")");
+  }
+  d.println();
+
+  d.print("RH:");
+  d.print(humidity, 1);
+  d.println("%");
+
+  if (elapsedSec > 0) {
+    d.print("Time:");
+    d.print(elapsedSec);
+    d.println("s");
+  }
+  d.println();
+
+  d.println(status);
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+struct BenchResult {
+  uint32_t enterRender;   // First frame (includes static text for fields)
+  uint32_t steadyRender;  // Mean of the remaining frames
+  uint32_t steadyFlush;
+};
+
+static void renderFrame(FieldDisplay& d, uint8_t screen, bool legacy, uint16_t frame, SensorInfo& s) {
+  // Readings wander by a few hundredths per frame, like a live sensor
+  s.temperature = 23.41 + 0.07 * (frame % 5);
+  s.humidity = 45.26 - 0.13 * (frame % 3);
+  computeDerivedMetrics((float)s.temperature, (float)s.humidity, s.derived);
+  int elapsed = 10 + frame * 2;
+
+  switch (screen) {
+    case SCREEN_MAIN_MENU:
+      if (legacy) legacyMainMenu(d, 1, s);
+      else drawMainMenuScreen(d, 1, s);
+      break;
+    case SCREEN_SENSOR_INFO:
+      if (legacy) legacySensorInfo(d, s);
+      else drawSensorInfoScreen(d, s);
+      break;
+    default:
+      if (legacy) legacyOperation(d, "CONDENSATION", "Heating...", s.temperature + 20.0, s.humidity / 4, 20.0, elapsed);
+      else drawOperationScreen(d, "CONDENSATION", "Heating...", s.temperature + 20.0, s.humidity / 4, 20.0, elapsed);
+      break;
+  }
+}
+
+static BenchResult benchScreen(FieldDisplay& d, uint8_t screen, bool legacy, SensorInfo& s) {
+  BenchResult r = { 0, 0, 0 };
+  uint32_t renderTotal = 0, flushTotal = 0;
+
+  d.clearDisplay();  // Force a fresh screen entry
+  d.display();
+
+  for (uint16_t frame = 0; frame < DISPLAY_BENCH_FRAMES; frame++) {
+    uint32_t start = cycleCount();
+    renderFrame(d, screen, legacy, frame, s);
+    uint32_t rendered = cycleCount();
+    d.display();
+    uint32_t flushed = cycleCount();
+
+    if (frame == 0) {
+      r.enterRender = rendered - start;
+    } else {
+      renderTotal += rendered - start;
+      flushTotal += flushed - rendered;
+    }
+  }
+
+  r.steadyRender = renderTotal / (DISPLAY_BENCH_FRAMES - 1);
+  r.steadyFlush = flushTotal / (DISPLAY_BENCH_FRAMES - 1);
+  return r;
+}
+
+void runDisplayBenchmark(FieldDisplay& d, Print& out) {
+  static const char* const SCREEN_NAMES[] = { "menu", "info", "op" };
+  static const uint8_t SCREENS[] = { SCREEN_MAIN_MENU, SCREEN_SENSOR_INFO, SCREEN_OPERATION };
+
+  SensorInfo s;
+  memset(&s, 0, sizeof(s));
+  s.nist_id = 0x544900003022ULL;
+  strcpy(s.nist_str, "544900003022");
+  s.temp_offset = -0.12;
+  s.humidity_offset = 1.87;
+
+  cycleCounterBegin();
+
+  out.println("BENCH cycles/frame (enter = first frame, render/flush = mean of the rest)");
+  out.println("BENCH screen path   enter  render   flush   total");
+
+  char line[80];
+  for (uint8_t i = 0; i < 3; i++) {
+    for (uint8_t pass = 0; pass < 2; pass++) {
+      bool legacy = pass == 0;
+      BenchResult r = benchScreen(d, SCREENS[i], legacy, s);
+      snprintf(line, sizeof(line), "BENCH %-6s %-6s %7lu %7lu %7lu %7lu",
+               SCREEN_NAMES[i], legacy ? "print" : "field",
+               (unsigned long)r.enterRender, (unsigned long)r.steadyRender,
+               (unsigned long)r.steadyFlush,
+               (unsigned long)(r.steadyRender + r.steadyFlush));
+      out.println(line);
+    }
+  }
+
+  d.clearDisplay();  // Normal screens redraw from scratch
+}
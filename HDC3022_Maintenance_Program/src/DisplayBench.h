@@ -0,0 +1,21 @@
+#ifndef DISPLAY_BENCH_H
+#define DISPLAY_BENCH_H
+
+#include <Arduino.h>
+#include "FieldDisplay.h"
+
+// ============================================================================
+// DISPLAY BENCHMARK
+// CPU cycles per frame for the field renderer vs. the previous full-redraw
+// GFX print() code, on the main menu, sensor info and operation screens.
+// Each frame is split into render (framebuffer work) and flush (display(),
+// the I2C transfer). Values drift slightly from frame to frame the way a
+// live reading does. Triggered by the BENCH serial command; the screen is
+// redrawn normally afterwards.
+// ============================================================================
+
+#define DISPLAY_BENCH_FRAMES 20
+
+void runDisplayBenchmark(FieldDisplay& d, Print& out);
+
+#endif
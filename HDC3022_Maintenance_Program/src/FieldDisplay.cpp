@@ -0,0 +1,126 @@
+#include "FieldDisplay.h"
+#include "Trace.h"
+
+FieldDisplay::FieldDisplay(uint16_t w, uint16_t h, TwoWire* twi, int8_t rst_pin,
+                           uint32_t clkDuring, uint32_t clkAfter)
+  : Adafruit_SH1107(w, h, twi, rst_pin, clkDuring, clkAfter),
+    glyphsReady(false), activeScreen(SCREEN_NONE), generation(1) {
+}
+
+void FieldDisplay::beginFields() {
+  // Render each glyph once through GFX and keep it as 8 row masks,
+  // bit n = glyph column n (6 columns including the spacing column)
+  GFXcanvas1 canvas(8, GLYPH_HEIGHT);
+
+  for (int c = GLYPH_FIRST; c <= GLYPH_LAST; c++) {
+    canvas.fillScreen(0);
+    canvas.drawChar(0, 0, (unsigned char)c, 1, 0, 1);
+    const uint8_t* rows = canvas.getBuffer();
+
+    for (int y = 0; y < GLYPH_HEIGHT; y++) {
+      uint8_t mask = 0;
+      for (int x = 0; x < GLYPH_WIDTH; x++) {
+        if (rows[y] & (0x80 >> x)) mask |= (uint8_t)(1 << x);
+      }
+      glyphs[c - GLYPH_FIRST][y] = mask;
+    }
+  }
+  glyphsReady = true;
+}
+
+void FieldDisplay::clearDisplay() {
+  Adafruit_SH1107::clearDisplay();
+  activeScreen = SCREEN_NONE;
+}
+
+void FieldDisplay::display() {
+  traceBuffer.begin(TRACE_EVT_DISPLAY_FLUSH);
+  Adafruit_SH1107::display();
+  traceBuffer.end(TRACE_EVT_DISPLAY_FLUSH);
+}
+
+bool FieldDisplay::enterScreen(uint8_t screenId) {
+  if (screenId == activeScreen) return false;
+
+  Adafruit_SH1107::clearDisplay();
+  activeScreen = screenId;
+  generation++;  // Every field on the new screen is stale
+  return true;
+}
+
+void FieldDisplay::markDirty(uint8_t colFirst, uint8_t colLast, uint8_t row) {
+  // Re-plot two opposite corners with their current colour so the driver's
+  // dirty window grows to cover the blitted cells
+  int16_t x1 = colFirst * GLYPH_WIDTH;
+  int16_t y1 = row * GLYPH_HEIGHT;
+  int16_t x2 = (colLast + 1) * GLYPH_WIDTH - 1;
+  int16_t y2 = y1 + GLYPH_HEIGHT - 1;
+  drawPixel(x1, y1, getPixel(x1, y1) ? SH110X_WHITE : SH110X_BLACK);
+  drawPixel(x2, y2, getPixel(x2, y2) ? SH110X_WHITE : SH110X_BLACK);
+}
+
+void FieldDisplay::blitGlyph(uint8_t col, uint8_t row, char c) {
+  if (c < GLYPH_FIRST || c > GLYPH_LAST) c = '?';
+
+  if (!glyphsReady || getRotation() != 1 || WIDTH != 64) {
+    // Generic path through GFX
+    fillRect(col * GLYPH_WIDTH, row * GLYPH_HEIGHT, GLYPH_WIDTH, GLYPH_HEIGHT, SH110X_BLACK);
+    drawChar(col * GLYPH_WIDTH, row * GLYPH_HEIGHT, c, SH110X_WHITE, SH110X_BLACK, 1);
+    return;
+  }
+
+  // Rotation 1: logical (x, y) lives at buffer[(63 - y) + (x / 8) * 64],
+  // bit x & 7. A glyph row is 6 consecutive bits of one buffer column,
+  // spanning at most two pages.
+  uint8_t* buf = getBuffer();
+  const uint8_t* glyph = glyphs[c - GLYPH_FIRST];
+  uint16_t x = col * GLYPH_WIDTH;
+  uint8_t page = x >> 3;
+  uint8_t shift = x & 7;
+  uint16_t keep = (uint16_t)~(0x3F << shift);
+  bool spans = shift > 8 - GLYPH_WIDTH;
+
+  for (uint8_t gy = 0; gy < GLYPH_HEIGHT; gy++) {
+    uint8_t* p = buf + (WIDTH - 1 - (row * GLYPH_HEIGHT + gy)) + page * WIDTH;
+    uint16_t bits = (uint16_t)glyph[gy] << shift;
+    p[0] = (uint8_t)((p[0] & keep) | bits);
+    if (spans) {
+      p[WIDTH] = (uint8_t)((p[WIDTH] & (keep >> 8)) | (bits >> 8));
+    }
+  }
+}
+
+void FieldDisplay::drawText(uint8_t col, uint8_t row, const char* text) {
+  if (row >= FIELD_ROWS) return;
+
+  uint8_t first = col;
+  while (*text != '\0' && col < FIELD_COLS) {
+    blitGlyph(col++, row, *text++);
+  }
+  if (col > first) markDirty(first, col - 1, row);
+}
+
+void FieldDisplay::updateField(TextField& field, const char* text) {
+  bool stale = field.generation != generation;
+  int16_t dirtyFirst = -1, dirtyLast = -1;
+  bool ended = false;
+
+  for (uint8_t i = 0; i < field.width && field.col + i < FIELD_COLS; i++) {
+    // Pad with spaces past the end of the new text
+    if (!ended && text[i] == '\0') ended = true;
+    char c = ended ? ' ' : text[i];
+
+    if (stale || field.shown[i] != c) {
+      blitGlyph(field.col + i, field.row, c);
+      field.shown[i] = c;
+      if (dirtyFirst < 0) dirtyFirst = i;
+      dirtyLast = i;
+    }
+  }
+  field.shown[field.width] = '\0';
+  field.generation = generation;
+
+  if (dirtyFirst >= 0) {
+    markDirty(field.col + dirtyFirst, field.col + dirtyLast, field.row);
+  }
+}
@@ -0,0 +1,77 @@
+#ifndef FIELD_DISPLAY_H
+#define FIELD_DISPLAY_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SH110X.h>
+
+// ============================================================================
+// FIELD DISPLAY
+// SH1107 with a fixed-cell text layer on top of the normal GFX API.
+//
+// A screen is a grid of 21 x 8 character cells (6 x 8 px, size 1 font).
+// Static text is drawn once when the screen is entered; TextFields are
+// re-rendered only in the cells whose character changed. Glyphs come from a
+// cache of the GFX font packed as row masks, blitted straight into the
+// rotated framebuffer, and display() only sends the window that was touched.
+//
+// Anything drawn through clearDisplay() + print() (result screens etc.)
+// still works - clearDisplay() makes the next enterScreen() start over.
+// ============================================================================
+
+#define FIELD_COLS 21
+#define FIELD_ROWS 8
+#define GLYPH_WIDTH 6
+#define GLYPH_HEIGHT 8
+#define GLYPH_FIRST ' '
+#define GLYPH_LAST '~'
+
+struct TextField {
+  uint8_t col;
+  uint8_t row;
+  uint8_t width;
+  uint32_t generation;         // Screen generation the shown text belongs to
+  char shown[FIELD_COLS + 1];  // What is in the framebuffer now
+};
+
+#define TEXT_FIELD(col, row, width) { col, row, width, 0, "" }
+
+class FieldDisplay : public Adafruit_SH1107 {
+public:
+  FieldDisplay(uint16_t w, uint16_t h, TwoWire* twi, int8_t rst_pin,
+               uint32_t clkDuring, uint32_t clkAfter);
+
+  // Build the glyph cache - call after begin() and setRotation()
+  void beginFields();
+
+  // Switch to screen id. Returns true if the screen was not already shown,
+  // in which case the framebuffer is cleared and the caller draws its
+  // static text.
+  bool enterScreen(uint8_t screenId);
+
+  // Static text at a cell position (clipped to the row)
+  void drawText(uint8_t col, uint8_t row, const char* text);
+
+  // Set a field; only changed cells are redrawn. Text is padded / clipped
+  // to the field width.
+  void updateField(TextField& field, const char* text);
+
+  // Forget the active screen as well as clearing the buffer
+  void clearDisplay();
+
+  // Send the touched window (traced as a display flush)
+  void display();
+
+private:
+  void blitGlyph(uint8_t col, uint8_t row, char c);
+  void markDirty(uint8_t colFirst, uint8_t colLast, uint8_t row);
+
+  uint8_t glyphs[GLYPH_LAST - GLYPH_FIRST + 1][GLYPH_HEIGHT];
+  bool glyphsReady;
+  uint8_t activeScreen;
+  uint32_t generation;
+};
+
+#define SCREEN_NONE 0xFF
+
+#endif
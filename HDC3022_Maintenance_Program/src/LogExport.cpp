@@ -0,0 +1,37 @@
+#include "LogExport.h"
+#include "SampleLog.h"
+
+// Static so a 256 record export doesn't need ~12 KB of stack
+static LogRecord exportRecords[LOG_CHUNK_MAX_RECORDS];
+static uint8_t exportScratch[LOG_CHUNK_MAX_RAW];
+static uint8_t exportChunk[LOG_CHUNK_MAX_SIZE];
+
+void exportSampleLog(Stream& port, uint32_t fromSeq) {
+  uint32_t first = fromSeq;
+  if (first < sampleLog.firstSeq()) first = sampleLog.firstSeq();
+  if (first > sampleLog.endSeq()) first = sampleLog.endSeq();
+  uint32_t end = sampleLog.endSeq();
+
+  port.print("EXPORT ");
+  port.print(first);
+  port.print(" ");
+  port.println(end - first);
+
+  uint32_t seq = first;
+  while (seq < end) {
+    size_t want = end - seq;
+    if (want > LOG_CHUNK_MAX_RECORDS) want = LOG_CHUNK_MAX_RECORDS;
+
+    size_t got = sampleLog.read(seq, exportRecords, want);
+    if (got == 0) break;
+
+    size_t size = logBuildChunk(seq, exportRecords, got, exportScratch, exportChunk);
+    port.write(exportChunk, size);
+    seq += got;
+  }
+
+  // Terminating empty chunk
+  size_t size = logBuildChunk(seq, exportRecords, 0, exportScratch, exportChunk);
+  port.write(exportChunk, size);
+  port.flush();
+}
@@ -0,0 +1,15 @@
+#ifndef LOG_EXPORT_H
+#define LOG_EXPORT_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// USB LOG EXPORT
+// Streams the sample log to Serial as CRC-checked compressed chunks (format
+// in lib/HdcCore/LogCodec.h). Started by the "EXPORT [seq]" serial command;
+// a host that loses sync re-issues EXPORT from the last record it verified.
+// ============================================================================
+
+void exportSampleLog(Stream& port, uint32_t fromSeq);
+
+#endif
@@ -0,0 +1,82 @@
+#include "MeasureStats.h"
+
+#include <math.h>
+
+MeasureStats measureStats;
+
+static const char* const SLOT_NAMES[MEASURE_SLOTS] = { "LP0", "LP1", "LP2", "LP3", "auto" };
+
+MeasureStats::MeasureStats() {
+  reset();
+}
+
+void MeasureStats::reset() {
+  memset(slots, 0, sizeof(slots));
+  lastSlot = MEASURE_SLOTS;
+}
+
+void MeasureStats::recordWait(MeasureSlotStats& s, uint32_t waitUs) {
+  s.totalWaitUs += waitUs;
+  if (waitUs > s.maxWaitUs) s.maxWaitUs = waitUs;
+}
+
+void MeasureStats::recordRead(uint8_t slot, uint32_t waitUs, double temperature, double humidity, bool steady) {
+  if (slot >= MEASURE_SLOTS) return;
+  MeasureSlotStats& s = slots[slot];
+
+  s.reads++;
+  recordWait(s, waitUs);
+
+  // A read in another mode (or a non-steady one) breaks the series
+  if (!steady || slot != lastSlot) s.seriesLength = 0;
+  lastSlot = steady ? slot : MEASURE_SLOTS;
+  if (!steady) return;
+
+  if (s.seriesLength >= 2) {
+    double dT = temperature - 2.0 * s.history[1][0] + s.history[0][0];
+    double dRH = humidity - 2.0 * s.history[1][1] + s.history[0][1];
+    s.sumSqTemp += dT * dT;
+    s.sumSqHumidity += dRH * dRH;
+    s.noiseSamples++;
+  } else {
+    s.seriesLength++;
+  }
+
+  s.history[0][0] = s.history[1][0];
+  s.history[0][1] = s.history[1][1];
+  s.history[1][0] = temperature;
+  s.history[1][1] = humidity;
+}
+
+void MeasureStats::recordFailure(uint8_t slot, uint32_t waitUs) {
+  if (slot >= MEASURE_SLOTS) return;
+  MeasureSlotStats& s = slots[slot];
+
+  s.reads++;
+  s.failures++;
+  recordWait(s, waitUs);
+  s.seriesLength = 0;
+  lastSlot = MEASURE_SLOTS;
+}
+
+void MeasureStats::printStats(Print& out) {
+  // Noise in milli-units (mC, m%RH) - no float printf on this core
+  out.println("mode    reads  fail  wait avg/max us    noise T mC  RH m%  samples");
+  for (uint8_t i = 0; i < MEASURE_SLOTS; i++) {
+    const MeasureSlotStats& s = slots[i];
+    if (s.reads == 0) continue;
+
+    unsigned long noiseT = 0, noiseRH = 0;
+    if (s.noiseSamples > 0) {
+      noiseT = (unsigned long)(1000.0 * sqrt(s.sumSqTemp / (6.0 * s.noiseSamples)) + 0.5);
+      noiseRH = (unsigned long)(1000.0 * sqrt(s.sumSqHumidity / (6.0 * s.noiseSamples)) + 0.5);
+    }
+
+    char line[96];
+    snprintf(line, sizeof(line), "%-5s %7lu %5lu %8lu/%-8lu %11lu %6lu %8lu",
+             SLOT_NAMES[i], (unsigned long)s.reads, (unsigned long)s.failures,
+             (unsigned long)(s.totalWaitUs / s.reads), (unsigned long)s.maxWaitUs,
+             noiseT, noiseRH, (unsigned long)s.noiseSamples);
+    out.println(line);
+  }
+}
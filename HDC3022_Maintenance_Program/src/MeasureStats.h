@@ -0,0 +1,58 @@
+#ifndef MEASURE_STATS_H
+#define MEASURE_STATS_H
+
+#include <Arduino.h>
+#include <HdcBackend.h>
+
+// ============================================================================
+// MEASUREMENT MODE STATISTICS
+// What each conversion mode actually costs and delivers on this unit:
+//   wait  - time from issuing the read to having the result (conversion +
+//           I2C), mean and max
+//   noise - 1-sigma of T and RH, estimated from second differences of
+//           consecutive readings in the same mode (a steady or linearly
+//           changing signal cancels: var(x[n] - 2x[n-1] + x[n-2]) = 6 sigma^2)
+// Slots LP0..LP3 are on-demand reads; MEASURE_SLOT_AUTO is the idle
+// auto-measurement mode, where the sensor converts on its own schedule and a
+// read only fetches the latest result.
+// ============================================================================
+
+#define MEASURE_SLOT_AUTO HDC_MODE_COUNT
+#define MEASURE_SLOTS (HDC_MODE_COUNT + 1)
+
+struct MeasureSlotStats {
+  uint32_t reads;
+  uint32_t failures;
+  uint64_t totalWaitUs;
+  uint32_t maxWaitUs;
+  uint32_t noiseSamples;
+  double sumSqTemp;      // Sum of squared second differences
+  double sumSqHumidity;
+  double history[2][2];  // Last two readings (T, RH) of the current series
+  uint8_t seriesLength;
+};
+
+class MeasureStats {
+public:
+  MeasureStats();
+
+  // One read in slot (0..3 = LP0..LP3, MEASURE_SLOT_AUTO). steady = the
+  // reading may feed the noise estimate (heater off, fixed read interval).
+  void recordRead(uint8_t slot, uint32_t waitUs, double temperature, double humidity, bool steady);
+  void recordFailure(uint8_t slot, uint32_t waitUs);
+
+  void reset();
+  void printStats(Print& out);
+
+  const MeasureSlotStats& slot(uint8_t id) const { return slots[id]; }
+
+private:
+  void recordWait(MeasureSlotStats& s, uint32_t waitUs);
+
+  MeasureSlotStats slots[MEASURE_SLOTS];
+  uint8_t lastSlot;
+};
+
+extern MeasureStats measureStats;
+
+#endif
@@ -0,0 +1,141 @@
+#include "MemoryStats.h"
+
+// Linker script symbols (ArduinoCore-samd flash_with_bootloader.ld): RAM
+// starts with .data, the heap starts at the end of .bss and the stack
+// grows down from the top of RAM
+extern "C" {
+  extern uint32_t __data_start__;
+  extern uint32_t __bss_end__;
+  extern uint32_t __StackTop;
+  char* sbrk(int incr);
+}
+
+// newlib-nano's free list (nano-mallocr.c). Its mallinfo() only reports
+// the free total, not how it is split up, so walk the list directly.
+struct NanoMallocChunk {
+  long size;
+  NanoMallocChunk* next;
+};
+extern "C" NanoMallocChunk* __malloc_free_list;
+
+MemoryStats memoryStats;
+
+static uint8_t* heapEnd() {
+  return (uint8_t*)sbrk(0);
+}
+
+static uint32_t* alignUp(uint8_t* p) {
+  return (uint32_t*)(((uintptr_t)p + 3) & ~(uintptr_t)3);
+}
+
+static uint32_t* alignDown(uint8_t* p) {
+  return (uint32_t*)((uintptr_t)p & ~(uintptr_t)3);
+}
+
+MemoryStats::MemoryStats()
+  : paintLow(0), paintHigh(0), stackPeak(0), heapUsedPeak(0), gapMin(0xFFFFFFFFUL) {
+  memset(&now, 0, sizeof(now));
+}
+
+void MemoryStats::begin() {
+  paint();
+  update();
+}
+
+void MemoryStats::paint() {
+  uint8_t marker;
+  uint32_t* low = alignUp(heapEnd() + MEMORY_HEAP_GUARD);
+  uint32_t* high = alignDown(&marker - MEMORY_STACK_GUARD);
+
+  paintLow = low;
+  paintHigh = high > low ? high : low;
+  for (uint32_t* p = paintLow; p < paintHigh; p++) {
+    *p = MEMORY_PAINT_PATTERN;
+  }
+}
+
+// Deepest stack use since the last paint, in bytes below the top of RAM
+uint32_t MemoryStats::scanStack() {
+  // The heap may have grown into the painted area since
+  uint32_t* p = alignUp(heapEnd());
+  if (p < paintLow) p = paintLow;
+  if (p > paintHigh) p = paintHigh;
+
+  while (p < paintHigh && *p == MEMORY_PAINT_PATTERN) {
+    p++;
+  }
+  return (uint32_t)((uint8_t*)&__StackTop - (uint8_t*)p);
+}
+
+void MemoryStats::update() {
+  uint8_t marker;
+  uint8_t* top = (uint8_t*)&__StackTop;
+  uint8_t* ramStart = (uint8_t*)&__data_start__;
+  uint8_t* heapBase = (uint8_t*)&__bss_end__;
+  uint8_t* brk = heapEnd();
+
+  uint32_t freeBytes = 0, freeChunks = 0, largestFree = 0;
+  for (NanoMallocChunk* c = __malloc_free_list; c != NULL; c = c->next) {
+    freeBytes += c->size;
+    freeChunks++;
+    if ((uint32_t)c->size > largestFree) largestFree = c->size;
+  }
+
+  now.totalRam = top - ramStart;
+  now.staticBytes = heapBase - ramStart;
+  now.heapArena = brk - heapBase;
+  now.heapFree = freeBytes;
+  now.heapFreeChunks = freeChunks;
+  now.heapLargestFree = largestFree;
+  now.heapUsed = now.heapArena - freeBytes;
+  now.stackUsed = top - &marker;
+  now.gap = &marker - brk;
+
+  uint32_t stack = scanStack();
+  if (now.stackUsed > stack) stack = now.stackUsed;
+  if (stack > stackPeak) stackPeak = stack;
+  if (now.heapUsed > heapUsedPeak) heapUsedPeak = now.heapUsed;
+
+  // Closest the deepest stack has come to the heap
+  int32_t gap = (int32_t)((top - stackPeak) - brk);
+  if (gap < 0) gap = 0;
+  if ((uint32_t)gap < gapMin) gapMin = gap;
+}
+
+void MemoryStats::resetPeaks() {
+  stackPeak = 0;
+  heapUsedPeak = 0;
+  gapMin = 0xFFFFFFFFUL;
+  paint();
+  update();
+}
+
+// 0..100: share of the free heap that is not in the largest free chunk
+uint8_t MemoryStats::fragmentation() const {
+  if (now.heapFree == 0) return 0;
+  return (uint8_t)(100 - (uint64_t)now.heapLargestFree * 100 / now.heapFree);
+}
+
+void MemoryStats::printStats(Print& out) {
+  char line[96];
+  out.println("memory         now    peak  (bytes)");
+  snprintf(line, sizeof(line), "ram        %7lu", (unsigned long)now.totalRam);
+  out.println(line);
+  snprintf(line, sizeof(line), "static     %7lu", (unsigned long)now.staticBytes);
+  out.println(line);
+  snprintf(line, sizeof(line), "heap arena %7lu", (unsigned long)now.heapArena);
+  out.println(line);
+  snprintf(line, sizeof(line), "heap used  %7lu %7lu", (unsigned long)now.heapUsed,
+           (unsigned long)heapUsedPeak);
+  out.println(line);
+  snprintf(line, sizeof(line), "heap free  %7lu          %lu chunks, largest %lu, fragmentation %u%%",
+           (unsigned long)now.heapFree, (unsigned long)now.heapFreeChunks,
+           (unsigned long)now.heapLargestFree, (unsigned)fragmentation());
+  out.println(line);
+  snprintf(line, sizeof(line), "stack      %7lu %7lu", (unsigned long)now.stackUsed,
+           (unsigned long)stackPeak);
+  out.println(line);
+  snprintf(line, sizeof(line), "free gap   %7lu %7lu  (peak = smallest)", (unsigned long)now.gap,
+           (unsigned long)gapMin);
+  out.println(line);
+}
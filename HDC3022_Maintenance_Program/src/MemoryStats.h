@@ -0,0 +1,71 @@
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// MEMORY STATISTICS
+// How much of the SAMD51's RAM is in use and how close the stack and the
+// heap have come to each other:
+//   static - .data + .bss (globals, framebuffers declared statically)
+//   heap   - extent of the malloc arena (sbrk), which only grows, so it is
+//            its own high-water mark; in use / free inside the arena, and
+//            the free bytes split over how many chunks (fragmentation)
+//   stack  - the free RAM between heap and stack is painted with a pattern
+//            at boot; the lowest overwritten word is the stack high water
+//   gap    - smallest distance seen between the heap end and the stack
+// update() samples the current values; it scans the painted area, so call
+// it from a slow task rather than from a hot path.
+// ============================================================================
+
+#define MEMORY_PAINT_PATTERN 0xA5A5A5A5UL
+#define MEMORY_HEAP_GUARD 256   // Bytes above the heap end left unpainted
+#define MEMORY_STACK_GUARD 64   // Bytes below the caller's frame left unpainted
+
+struct MemorySnapshot {
+  uint32_t totalRam;
+  uint32_t staticBytes;
+  uint32_t heapArena;       // Bytes taken from sbrk
+  uint32_t heapUsed;        // Allocated inside the arena
+  uint32_t heapFree;        // Free inside the arena (reusable by malloc only)
+  uint32_t heapFreeChunks;  // Number of pieces heapFree is split into
+  uint32_t heapLargestFree; // Biggest of those
+  uint32_t stackUsed;       // Current depth at the update() call
+  uint32_t gap;             // Heap end to stack pointer now
+};
+
+class MemoryStats {
+public:
+  MemoryStats();
+
+  // Paint the free RAM. Call first thing in setup().
+  void begin();
+  void update();
+
+  // Forget the peaks: repaint below the caller and restart the heap peaks
+  // from the current values
+  void resetPeaks();
+
+  void printStats(Print& out);
+
+  const MemorySnapshot& current() const { return now; }
+  uint32_t stackHighWater() const { return stackPeak; }
+  uint32_t heapUsedHighWater() const { return heapUsedPeak; }
+  uint32_t minGap() const { return gapMin; }
+  uint8_t fragmentation() const;  // % of the free heap outside the largest chunk
+
+private:
+  void paint();
+  uint32_t scanStack();
+
+  MemorySnapshot now;
+  uint32_t* paintLow;   // Painted area [paintLow, paintHigh)
+  uint32_t* paintHigh;
+  uint32_t stackPeak;
+  uint32_t heapUsedPeak;
+  uint32_t gapMin;
+};
+
+extern MemoryStats memoryStats;
+
+#endif
@@ -0,0 +1,77 @@
+#include "RecipeStore.h"
+#include "SampleLog.h"
+
+#include <Adafruit_SPIFlash.h>
+
+extern Adafruit_SPIFlash flash;  // SampleLog.cpp
+
+RecipeStore recipeStore;
+
+// Slot layout: 2 byte length, then the encoded recipe
+#define RECIPE_SLOT_HEADER 2
+
+uint32_t RecipeStore::slotAddress(MaintenanceOperation operation) const {
+  if (!recipeOperationSupported(operation) || (unsigned)operation >= LOG_RESERVED_SECTORS) {
+    return LOG_NO_SECTOR;
+  }
+  return sampleLog.reservedAddress((uint8_t)operation);
+}
+
+bool RecipeStore::load(MaintenanceOperation operation, Recipe& recipe) {
+  uint32_t address = slotAddress(operation);
+  if (address == LOG_NO_SECTOR) return false;
+
+  uint8_t data[RECIPE_MAX_SIZE];
+  uint16_t len;
+  flash.readBuffer(address, (uint8_t*)&len, sizeof(len));
+  if (len > RECIPE_MAX_SIZE) return false;  // Erased (0xFFFF) or garbage
+  flash.readBuffer(address + RECIPE_SLOT_HEADER, data, len);
+
+  if (recipeDecode(data, len, recipe) != RECIPE_OK) return false;
+  return recipe.operation == operation;
+}
+
+RecipeStatus RecipeStore::store(const uint8_t* data, size_t len) {
+  Recipe recipe;
+  RecipeStatus status = recipeDecode(data, len, recipe);
+  if (status != RECIPE_OK) return status;
+
+  uint32_t address = slotAddress(recipe.operation);
+  if (address == LOG_NO_SECTOR) return RECIPE_BAD_OPERATION;
+
+  uint16_t length = (uint16_t)len;
+  flash.eraseSector(address / LOG_SECTOR_SIZE);
+  flash.writeBuffer(address, (const uint8_t*)&length, sizeof(length));
+  flash.writeBuffer(address + RECIPE_SLOT_HEADER, data, len);
+
+  // Read back through the same checks a run will use
+  Recipe check;
+  if (!load(recipe.operation, check)) return RECIPE_BAD_CRC;
+  return RECIPE_OK;
+}
+
+bool RecipeStore::clear(MaintenanceOperation operation) {
+  uint32_t address = slotAddress(operation);
+  if (address == LOG_NO_SECTOR) return false;
+  flash.eraseSector(address / LOG_SECTOR_SIZE);
+  return true;
+}
+
+void RecipeStore::printList(Print& out) {
+  static const MaintenanceOperation OPS[] = { MAINT_OP_CONDENSATION, MAINT_OP_OFFSET_CORRECTION,
+                                              MAINT_OP_COMBINED };
+
+  for (size_t i = 0; i < sizeof(OPS) / sizeof(OPS[0]); i++) {
+    Recipe recipe;
+    out.print("RECIPE ");
+    out.print((int)OPS[i]);
+    if (load(OPS[i], recipe)) {
+      out.print(" ");
+      out.print(recipe.stepCount);
+      out.print(" ");
+      out.println(recipe.name);
+    } else {
+      out.println(" built-in");
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef RECIPE_STORE_H
+#define RECIPE_STORE_H
+
+#include <Arduino.h>
+#include <Recipe.h>
+
+// ============================================================================
+// RECIPE STORE
+// Maintenance recipes (lib/HdcCore/Recipe.h) kept in the QSPI flash sectors
+// the sample log leaves free, one sector per operation. A stored recipe
+// replaces the built-in procedure for its operation - from the menu, the
+// buttons and RUN commands alike - until it is cleared. Recipes are checked
+// (CRC, recipeValidate) when stored and again every time they are loaded.
+// ============================================================================
+
+class RecipeStore {
+public:
+  // Stored recipe for the operation; false if none (use the built-in one)
+  bool load(MaintenanceOperation operation, Recipe& recipe);
+
+  // Validate and store an encoded recipe in its operation's slot
+  RecipeStatus store(const uint8_t* data, size_t len);
+
+  // Back to the built-in procedure
+  bool clear(MaintenanceOperation operation);
+
+  // One line per operation: "RECIPE <op> <steps> <name>" or
+  // "RECIPE <op> built-in"
+  void printList(Print& out);
+
+private:
+  uint32_t slotAddress(MaintenanceOperation operation) const;
+};
+
+extern RecipeStore recipeStore;
+
+#endif
@@ -0,0 +1,167 @@
+#include "SampleLog.h"
+#include "Trace.h"
+
+#include <Adafruit_SPIFlash.h>
+
+Adafruit_FlashTransport_QSPI flashTransport;
+Adafruit_SPIFlash flash(&flashTransport);
+
+SampleLog sampleLog;
+
+#define LOG_ERASED 0xFFFFFFFF
+
+SampleLog::SampleLog()
+  : available(false), sectorCount(0), oldestSeq(0), nextSeq(0), boot(0) {
+}
+
+uint32_t SampleLog::sectorAddress(uint32_t sectorSeq) const {
+  return (sectorSeq % sectorCount) * LOG_SECTOR_SIZE;
+}
+
+bool SampleLog::begin() {
+  if (!flash.begin()) {
+    Serial.println("Sample log: no QSPI flash");
+    return false;
+  }
+
+  uint32_t chipSectors = flash.size() / LOG_SECTOR_SIZE;
+  if (chipSectors <= LOG_RESERVED_SECTORS) return false;
+  sectorCount = chipSectors - LOG_RESERVED_SECTORS;
+
+  // Find the newest and oldest written sectors
+  uint32_t newestSector = LOG_ERASED;
+  uint32_t oldestSector = LOG_ERASED;
+  bool relocated = false;
+  for (uint32_t i = 0; i < sectorCount; i++) {
+    uint32_t seq;
+    flash.readBuffer(i * LOG_SECTOR_SIZE, (uint8_t*)&seq, sizeof(seq));
+    if (seq == LOG_ERASED) continue;
+    // Written with a different ring size (before the reserved sectors)
+    if (seq % sectorCount != i) relocated = true;
+    if (newestSector == LOG_ERASED || seq > newestSector) newestSector = seq;
+    if (oldestSector == LOG_ERASED || seq < oldestSector) oldestSector = seq;
+  }
+
+  available = true;
+
+  if (relocated) {
+    Serial.println("Sample log: ring size changed, erasing the log");
+    clear();
+    newestSector = LOG_ERASED;
+  }
+
+  if (newestSector == LOG_ERASED) {
+    // Empty log
+    oldestSeq = 0;
+    nextSeq = 0;
+    boot = 1;
+  } else {
+    // First free slot in the newest sector
+    uint32_t slot = 0;
+    uint32_t base = sectorAddress(newestSector) + 4;
+    while (slot < LOG_RECORDS_PER_SECTOR) {
+      uint32_t uptime;
+      flash.readBuffer(base + slot * sizeof(LogRecord), (uint8_t*)&uptime, sizeof(uptime));
+      if (uptime == LOG_ERASED) break;
+      slot++;
+    }
+
+    oldestSeq = oldestSector * LOG_RECORDS_PER_SECTOR;
+    nextSeq = newestSector * LOG_RECORDS_PER_SECTOR + slot;
+
+    LogRecord last;
+    boot = 1;
+    if (nextSeq > oldestSeq && read(nextSeq - 1, &last, 1) == 1) {
+      boot = last.boot + 1;
+    }
+  }
+
+  Serial.print("Sample log: ");
+  Serial.print(nextSeq - oldestSeq);
+  Serial.print(" records, boot #");
+  Serial.println(boot);
+  return true;
+}
+
+void SampleLog::append(const LogRecord& record) {
+  if (!available) return;
+
+  uint32_t sectorSeq = nextSeq / LOG_RECORDS_PER_SECTOR;
+  uint32_t slot = nextSeq % LOG_RECORDS_PER_SECTOR;
+  uint32_t address = sectorAddress(sectorSeq);
+  traceBuffer.begin(TRACE_EVT_LOG_WRITE, slot == 0);
+
+  if (slot == 0) {
+    // Starting a new sector - reclaim the oldest one if the ring is full
+    flash.eraseSector(address / LOG_SECTOR_SIZE);
+    flash.writeBuffer(address, (const uint8_t*)&sectorSeq, sizeof(sectorSeq));
+    if (sectorSeq >= sectorCount) {
+      oldestSeq = (sectorSeq - sectorCount + 1) * LOG_RECORDS_PER_SECTOR;
+    }
+  }
+
+  flash.writeBuffer(address + 4 + slot * sizeof(LogRecord), (const uint8_t*)&record, sizeof(record));
+  nextSeq++;
+  traceBuffer.end(TRACE_EVT_LOG_WRITE, slot == 0);
+}
+
+void SampleLog::logSample(double temperature, double humidity) {
+  LogRecord r;
+  r.uptimeSec = millis() / 1000;
+  r.boot = boot;
+  r.type = LOG_SAMPLE;
+  r.flags = 0;
+  r.a = (int16_t)lround(temperature * 100.0);
+  r.b = (int16_t)lround(humidity * 100.0);
+  append(r);
+}
+
+void SampleLog::logOperation(uint8_t operation, bool success, unsigned long durationMs, double humidityOffset) {
+  LogRecord r;
+  r.uptimeSec = millis() / 1000;
+  r.boot = boot;
+  r.type = LOG_OPERATION;
+  r.flags = operation | (success ? LOG_FLAG_SUCCESS : 0);
+  r.a = (int16_t)(durationMs / 1000);
+  r.b = (int16_t)lround(humidityOffset * 100.0);
+  append(r);
+}
+
+size_t SampleLog::read(uint32_t seq, LogRecord* records, size_t count) {
+  size_t n = 0;
+  while (n < count && seq < nextSeq) {
+    if (seq < oldestSeq) seq = oldestSeq;
+
+    // Contiguous run within one sector
+    uint32_t slot = seq % LOG_RECORDS_PER_SECTOR;
+    size_t run = LOG_RECORDS_PER_SECTOR - slot;
+    if (run > count - n) run = count - n;
+    if (run > nextSeq - seq) run = nextSeq - seq;
+
+    uint32_t address = sectorAddress(seq / LOG_RECORDS_PER_SECTOR) + 4 + slot * sizeof(LogRecord);
+    flash.readBuffer(address, (uint8_t*)&records[n], run * sizeof(LogRecord));
+    n += run;
+    seq += run;
+  }
+  return n;
+}
+
+void SampleLog::clear() {
+  if (!available) return;
+
+  // Sector by sector, skipping blank ones (the chip erase would take the
+  // recipes too). A sector's header is written before any of its records.
+  for (uint32_t i = 0; i < sectorCount; i++) {
+    uint32_t seq;
+    flash.readBuffer(i * LOG_SECTOR_SIZE, (uint8_t*)&seq, sizeof(seq));
+    if (seq != LOG_ERASED) flash.eraseSector(i);
+  }
+  flash.waitUntilReady();
+  oldestSeq = 0;
+  nextSeq = 0;
+}
+
+uint32_t SampleLog::reservedAddress(uint8_t i) const {
+  if (!available || i >= LOG_RESERVED_SECTORS) return LOG_NO_SECTOR;
+  return (sectorCount + i) * LOG_SECTOR_SIZE;
+}
@@ -0,0 +1,62 @@
+#ifndef SAMPLE_LOG_H
+#define SAMPLE_LOG_H
+
+#include <Arduino.h>
+#include <LogCodec.h>
+
+// ============================================================================
+// SAMPLE LOG
+// Ring buffer of LogRecords in the Feather M4's 2 MB QSPI flash. The ring
+// is the whole chip except the top LOG_RESERVED_SECTORS, which hold the
+// stored maintenance recipes (RecipeStore.h).
+//
+// Each 4 KB sector holds a 4 byte sequence number followed by 341 records.
+// Record sequence numbers are global: sectorSeq * 341 + slot, so an export
+// can resume from any record no matter how far the ring has wrapped.
+// ============================================================================
+
+#define LOG_SECTOR_SIZE 4096
+#define LOG_RECORDS_PER_SECTOR ((LOG_SECTOR_SIZE - 4) / sizeof(LogRecord))
+#define LOG_RESERVED_SECTORS 4
+#define LOG_NO_SECTOR 0xFFFFFFFFUL
+
+class SampleLog {
+public:
+  SampleLog();
+
+  // Mount the flash and find the head of the ring. Returns false if no flash.
+  bool begin();
+  bool ready() const { return available; }
+
+  void logSample(double temperature, double humidity);
+  void logOperation(uint8_t operation, bool success, unsigned long durationMs, double humidityOffset);
+
+  // Global sequence numbers of the oldest record and one past the newest
+  uint32_t firstSeq() const { return oldestSeq; }
+  uint32_t endSeq() const { return nextSeq; }
+  uint16_t bootNumber() const { return boot; }
+
+  // Read up to count records starting at seq. Returns records read.
+  size_t read(uint32_t seq, LogRecord* records, size_t count);
+
+  // Erase the whole log (not the reserved sectors)
+  void clear();
+
+  // Flash address of reserved sector i (0..LOG_RESERVED_SECTORS-1), or
+  // LOG_NO_SECTOR without flash
+  uint32_t reservedAddress(uint8_t i) const;
+
+private:
+  void append(const LogRecord& record);
+  uint32_t sectorAddress(uint32_t sectorSeq) const;
+
+  bool available;
+  uint32_t sectorCount;
+  uint32_t oldestSeq;
+  uint32_t nextSeq;
+  uint16_t boot;
+};
+
+extern SampleLog sampleLog;
+
+#endif
@@ -0,0 +1,141 @@
+#include "Scheduler.h"
+#include "Trace.h"
+
+Scheduler scheduler;
+
+// micros() wraps every ~71 minutes - compare times by signed difference
+static inline int32_t timeDiff(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b);
+}
+
+Scheduler::Scheduler() : count(0), ignoreRun(false) {
+  memset(tasks, 0, sizeof(tasks));
+}
+
+int Scheduler::add(const char* name, TaskFunction fn, uint32_t periodUs, uint32_t delayUs,
+                   uint32_t budgetUs, uint8_t priority) {
+  // Reuse a finished one-shot slot before growing the table
+  int id = -1;
+  for (uint8_t i = 0; i < count; i++) {
+    if (!tasks[i].active && tasks[i].periodUs == 0) {
+      id = i;
+      break;
+    }
+  }
+  if (id < 0) {
+    if (count >= SCHEDULER_MAX_TASKS) return -1;
+    id = count++;
+  }
+
+  SchedulerTask& t = tasks[id];
+  memset(&t, 0, sizeof(t));
+  t.name = name;
+  t.fn = fn;
+  t.periodUs = periodUs;
+  t.budgetUs = budgetUs;
+  t.priority = priority;
+  t.dueUs = micros() + delayUs;
+  t.active = true;
+  return id;
+}
+
+int Scheduler::addPeriodic(const char* name, TaskFunction fn, uint32_t periodMs, uint32_t budgetMs, uint8_t priority) {
+  return add(name, fn, periodMs * 1000UL, 0, budgetMs * 1000UL, priority);
+}
+
+int Scheduler::addOneShot(const char* name, TaskFunction fn, uint32_t delayMs, uint32_t budgetMs, uint8_t priority) {
+  return add(name, fn, 0, delayMs * 1000UL, budgetMs * 1000UL, priority);
+}
+
+void Scheduler::run() {
+  uint32_t now = micros();
+
+  // Earliest deadline among due tasks
+  int next = -1;
+  for (uint8_t i = 0; i < count; i++) {
+    const SchedulerTask& t = tasks[i];
+    if (!t.active || timeDiff(now, t.dueUs) < 0) continue;
+
+    if (next < 0) {
+      next = i;
+      continue;
+    }
+    int32_t order = timeDiff(t.dueUs, tasks[next].dueUs);
+    if (order < 0 || (order == 0 && t.priority > tasks[next].priority)) {
+      next = i;
+    }
+  }
+  if (next < 0) return;
+
+  SchedulerTask& t = tasks[next];
+  uint32_t jitter = now - t.dueUs;
+
+  ignoreRun = false;
+  uint32_t start = micros();
+  traceBuffer.begin(TRACE_EVT_TASK, next);
+  t.fn();
+  traceBuffer.end(TRACE_EVT_TASK, next);
+  uint32_t exec = micros() - start;
+
+  if (ignoreRun) {
+    // Intentional stall - restart every schedule from now
+    uint32_t resume = micros();
+    for (uint8_t i = 0; i < count; i++) {
+      if (tasks[i].active) tasks[i].dueUs = resume + (i == next ? tasks[i].periodUs : 0);
+    }
+    if (t.periodUs == 0) t.active = false;
+    return;
+  }
+
+  TaskStats& s = t.stats;
+  s.runs++;
+  s.totalJitterUs += jitter;
+  if (jitter > s.maxJitterUs) s.maxJitterUs = jitter;
+  s.lastExecUs = exec;
+  if (exec > s.maxExecUs) s.maxExecUs = exec;
+  if (t.budgetUs > 0 && exec > t.budgetUs) s.overruns++;
+
+  if (t.periodUs == 0) {
+    t.active = false;
+    return;
+  }
+
+  // Deadline = end of the period the task was due in
+  if (jitter >= t.periodUs) s.missed++;
+
+  // Fixed-rate reschedule, skipping periods that are already over
+  t.dueUs += t.periodUs;
+  uint32_t after = micros();
+  while (timeDiff(after, t.dueUs) >= (int32_t)t.periodUs) {
+    t.dueUs += t.periodUs;
+    s.skippedPeriods++;
+  }
+}
+
+void Scheduler::ignoreCurrentRun() {
+  ignoreRun = true;
+}
+
+void Scheduler::resetStats() {
+  for (uint8_t i = 0; i < count; i++) {
+    memset(&tasks[i].stats, 0, sizeof(TaskStats));
+  }
+}
+
+void Scheduler::printStats(Print& out) {
+  out.println("task       runs   jit avg/max us   exec max us  missed overrun skipped");
+  for (uint8_t i = 0; i < count; i++) {
+    const SchedulerTask& t = tasks[i];
+    if (t.periodUs == 0 && !t.active && t.stats.runs == 0) continue;
+
+    const TaskStats& s = t.stats;
+    char line[96];
+    snprintf(line, sizeof(line), "%-8s %6lu %8lu/%-8lu %10lu %7lu %7lu %7lu",
+             t.name, (unsigned long)s.runs,
+             (unsigned long)(s.runs ? s.totalJitterUs / s.runs : 0),
+             (unsigned long)s.maxJitterUs, (unsigned long)s.maxExecUs,
+             (unsigned long)s.missed, (unsigned long)s.overruns,
+             (unsigned long)s.skippedPeriods);
+    out.println(line);
+  }
+}
@@ -0,0 +1,76 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// COOPERATIVE SCHEDULER
+// Replaces the hand-rolled "currentMillis - last >= interval" checks in
+// loop(). Each call to run() starts the due task with the earliest deadline
+// (ties go to the higher priority) and records, per task:
+//   jitter   - how late the task started vs. its due time
+//   missed   - starts later than the deadline (one period)
+//   overruns - runs longer than the task's budget
+// Periodic tasks are fixed-rate; whole periods lost to a long stall are
+// skipped rather than run back to back.
+// ============================================================================
+
+#define SCHEDULER_MAX_TASKS 8
+
+typedef void (*TaskFunction)();
+
+struct TaskStats {
+  uint32_t runs;
+  uint32_t missed;
+  uint32_t overruns;
+  uint32_t skippedPeriods;
+  uint32_t maxJitterUs;
+  uint64_t totalJitterUs;
+  uint32_t maxExecUs;
+  uint32_t lastExecUs;
+};
+
+struct SchedulerTask {
+  const char* name;
+  TaskFunction fn;
+  uint32_t periodUs;   // 0 = one-shot
+  uint32_t budgetUs;
+  uint8_t priority;    // Higher runs first when deadlines tie
+  uint32_t dueUs;
+  bool active;
+  TaskStats stats;
+};
+
+class Scheduler {
+public:
+  Scheduler();
+
+  // Returns the task id, or -1 if the table is full
+  int addPeriodic(const char* name, TaskFunction fn, uint32_t periodMs, uint32_t budgetMs, uint8_t priority);
+  int addOneShot(const char* name, TaskFunction fn, uint32_t delayMs, uint32_t budgetMs, uint8_t priority);
+
+  // Run at most one due task. Call from loop().
+  void run();
+
+  // The running task blocked on purpose (confirmation screen, maintenance
+  // operation): don't count this run and restart every schedule from now.
+  void ignoreCurrentRun();
+
+  void resetStats();
+  void printStats(Print& out);
+
+  uint8_t taskCount() const { return count; }
+  const SchedulerTask& task(uint8_t id) const { return tasks[id]; }
+
+private:
+  int add(const char* name, TaskFunction fn, uint32_t periodUs, uint32_t delayUs,
+          uint32_t budgetUs, uint8_t priority);
+
+  SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+  uint8_t count;
+  bool ignoreRun;
+};
+
+extern Scheduler scheduler;
+
+#endif
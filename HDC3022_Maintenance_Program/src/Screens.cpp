@@ -0,0 +1,226 @@
+#include "Screens.h"
+#include "Scheduler.h"
+#include "MemoryStats.h"
+#include <TextFormat.h>
+
+static const char* const MENU_ITEM_TEXT[MAIN_MENU_ITEMS] = {
+  "1.View Sensor Info",
+  "2.Condensation Rem.",
+  "3.Offset Correction",
+  "4.Reset Offsets",
+  "5.Diagnostics",
+  "6.Quick Triage",
+  "7.Dry + Offset"
+};
+
+// ============================================================================
+// MAIN MENU
+// ============================================================================
+
+// Items fill rows 0-6 above the footer (no room left for a title)
+static TextField menuCursor[MAIN_MENU_ITEMS] = {
+  TEXT_FIELD(0, 0, 2), TEXT_FIELD(0, 1, 2), TEXT_FIELD(0, 2, 2), TEXT_FIELD(0, 3, 2),
+  TEXT_FIELD(0, 4, 2), TEXT_FIELD(0, 5, 2), TEXT_FIELD(0, 6, 2)
+};
+static TextField menuFooter = TEXT_FIELD(0, 7, FIELD_COLS);
+
+void drawMainMenuScreen(FieldDisplay& d, uint8_t selection, const SensorInfo& s) {
+  if (d.enterScreen(SCREEN_MAIN_MENU)) {
+    for (uint8_t i = 0; i < MAIN_MENU_ITEMS; i++) {
+      d.drawText(2, i, MENU_ITEM_TEXT[i]);
+    }
+  }
+
+  for (uint8_t i = 0; i < MAIN_MENU_ITEMS; i++) {
+    d.updateField(menuCursor[i], i == selection ? "> " : "  ");
+  }
+
+  // Current values footer
+  char line[FIELD_COLS + 1];
+  size_t pos = appendText(line, sizeof(line), 0, "T:");
+  pos = appendFixed(line, sizeof(line), pos, s.temperature, 1);
+  pos = appendText(line, sizeof(line), pos, "C RH:");
+  pos = appendFixed(line, sizeof(line), pos, s.humidity, 1);
+  appendText(line, sizeof(line), pos, "%");
+  d.updateField(menuFooter, line);
+}
+
+// ============================================================================
+// SENSOR INFO
+// ============================================================================
+
+static TextField infoTemp = TEXT_FIELD(6, 3, 6);
+static TextField infoHumidity = TEXT_FIELD(6, 4, 6);
+static TextField infoDewPoint = TEXT_FIELD(15, 3, 6);
+static TextField infoMargin = TEXT_FIELD(15, 4, 6);
+static TextField infoAbsolute = TEXT_FIELD(15, 5, 6);
+static TextField infoOffsets = TEXT_FIELD(0, 6, FIELD_COLS);
+
+// Value with one decimal and a unit into a field-sized buffer
+static void formatValue(char* buf, size_t len, double value, const char* unit) {
+  size_t pos = formatFixed(buf, len, value, 1);
+  appendText(buf, len, pos, unit);
+}
+
+void drawSensorInfoScreen(FieldDisplay& d, const SensorInfo& s) {
+  if (d.enterScreen(SCREEN_SENSOR_INFO)) {
+    d.drawText(0, 0, "SENSOR INFO");
+    d.drawText(0, 1, "------------");
+    d.drawText(0, 2, "ID:");
+    d.drawText(3, 2, s.nist_str);
+    d.drawText(0, 3, "Temp:");
+    d.drawText(0, 4, "RH:");
+    d.drawText(0, 5, "Offsets:");
+    // Right column: dew point, margin to condensation, absolute humidity (g/m3)
+    d.drawText(12, 3, "Dp:");
+    d.drawText(12, 4, "Mg:");
+    d.drawText(12, 5, "AH:");
+    d.drawText(0, 7, "Press C to exit");
+  }
+
+  char line[FIELD_COLS + 1];
+  formatValue(line, sizeof(line), s.temperature, "C");
+  d.updateField(infoTemp, line);
+
+  formatValue(line, sizeof(line), s.humidity, "%");
+  d.updateField(infoHumidity, line);
+
+  formatValue(line, sizeof(line), s.derived.dewPoint, "C");
+  d.updateField(infoDewPoint, line);
+
+  formatValue(line, sizeof(line), s.derived.margin, "C");
+  d.updateField(infoMargin, line);
+
+  formatValue(line, sizeof(line), s.derived.absoluteHumidity, "g");
+  d.updateField(infoAbsolute, line);
+
+  size_t pos = appendText(line, sizeof(line), 0, " T:");
+  pos = appendFixed(line, sizeof(line), pos, s.temp_offset, 2);
+  pos = appendText(line, sizeof(line), pos, " RH:");
+  appendFixed(line, sizeof(line), pos, s.humidity_offset, 2);
+  d.updateField(infoOffsets, line);
+}
+
+// ============================================================================
+// DIAGNOSTICS
+// ============================================================================
+
+#define DIAG_TASK_ROWS 5
+
+static TextField diagTask[DIAG_TASK_ROWS] = {
+  TEXT_FIELD(0, 2, FIELD_COLS), TEXT_FIELD(0, 3, FIELD_COLS), TEXT_FIELD(0, 4, FIELD_COLS),
+  TEXT_FIELD(0, 5, FIELD_COLS), TEXT_FIELD(0, 6, FIELD_COLS)
+};
+
+void drawDiagnosticsScreen(FieldDisplay& d) {
+  if (d.enterScreen(SCREEN_DIAGNOSTICS)) {
+    // Title and column headings (times in ms)
+    d.drawText(0, 0, "DIAGNOSTICS");
+    d.drawText(0, 1, "task   jit exec miss");
+    d.drawText(0, 7, "A:Page B:Reset C:Exit");
+  }
+
+  // One line per task: max jitter, max execution time, missed deadlines
+  char line[FIELD_COLS + 1];
+  uint8_t shown = 0;
+  for (uint8_t i = 0; i < scheduler.taskCount() && shown < DIAG_TASK_ROWS; i++) {
+    const SchedulerTask& t = scheduler.task(i);
+    if (t.periodUs == 0) continue;
+    snprintf(line, sizeof(line), "%-7.7s%3lu%5lu%5lu",
+             t.name,
+             (unsigned long)(t.stats.maxJitterUs / 1000),
+             (unsigned long)(t.stats.maxExecUs / 1000),
+             (unsigned long)t.stats.missed);
+    d.updateField(diagTask[shown++], line);
+  }
+  while (shown < DIAG_TASK_ROWS) {
+    d.updateField(diagTask[shown++], "");
+  }
+}
+
+// ============================================================================
+// MEMORY (second diagnostics page)
+// ============================================================================
+
+#define MEM_ROWS 5
+
+static TextField memRow[MEM_ROWS] = {
+  TEXT_FIELD(0, 2, FIELD_COLS), TEXT_FIELD(0, 3, FIELD_COLS), TEXT_FIELD(0, 4, FIELD_COLS),
+  TEXT_FIELD(0, 5, FIELD_COLS), TEXT_FIELD(0, 6, FIELD_COLS)
+};
+
+// Name, value now, peak (bytes)
+static void formatMemRow(char* line, size_t len, const char* name,
+                         unsigned long now, unsigned long peak) {
+  snprintf(line, len, "%-7s%7lu%7lu", name, now, peak);
+}
+
+void drawMemoryScreen(FieldDisplay& d) {
+  if (d.enterScreen(SCREEN_MEMORY)) {
+    d.drawText(0, 0, "MEMORY");
+    d.drawText(0, 1, "           now   peak");
+    d.drawText(0, 7, "A:Page B:Reset C:Exit");
+  }
+
+  const MemorySnapshot& m = memoryStats.current();
+  char line[FIELD_COLS + 1];
+  snprintf(line, sizeof(line), "%-7s%7lu", "static", (unsigned long)m.staticBytes);
+  d.updateField(memRow[0], line);
+  formatMemRow(line, sizeof(line), "heap", m.heapUsed, memoryStats.heapUsedHighWater());
+  d.updateField(memRow[1], line);
+  formatMemRow(line, sizeof(line), "stack", m.stackUsed, memoryStats.stackHighWater());
+  d.updateField(memRow[2], line);
+  // Peak column: the smallest gap seen
+  formatMemRow(line, sizeof(line), "gap", m.gap, memoryStats.minGap());
+  d.updateField(memRow[3], line);
+  snprintf(line, sizeof(line), "free%5lu/%luch %2u%%",
+           (unsigned long)m.heapFree, (unsigned long)m.heapFreeChunks,
+           (unsigned)memoryStats.fragmentation());
+  d.updateField(memRow[4], line);
+}
+
+// ============================================================================
+// OPERATION PROGRESS
+// ============================================================================
+
+static TextField opTitle = TEXT_FIELD(0, 0, FIELD_COLS);
+static TextField opTemp = TEXT_FIELD(0, 2, FIELD_COLS);
+static TextField opHumidity = TEXT_FIELD(0, 3, FIELD_COLS);
+static TextField opTime = TEXT_FIELD(0, 4, FIELD_COLS);
+static TextField opStatus = TEXT_FIELD(0, 6, FIELD_COLS);
+
+void drawOperationScreen(FieldDisplay& d, const char* title, const char* status,
+                         float temp, float humidity, float tempRise, int elapsedSec) {
+  if (d.enterScreen(SCREEN_OPERATION)) {
+    d.drawText(0, 1, "------------");
+  }
+  d.updateField(opTitle, title);
+
+  // Temperature with rise
+  char line[FIELD_COLS + 1];
+  size_t pos = appendText(line, sizeof(line), 0, "T:");
+  pos = appendFixed(line, sizeof(line), pos, temp, 1);
+  pos = appendText(line, sizeof(line), pos, "C");
+  if (tempRise > 0) {
+    pos = appendText(line, sizeof(line), pos, " (+");
+    pos = appendFixed(line, sizeof(line), pos, tempRise, 1);
+    appendText(line, sizeof(line), pos, ")");
+  }
+  d.updateField(opTemp, line);
+
+  pos = appendText(line, sizeof(line), 0, "RH:");
+  pos = appendFixed(line, sizeof(line), pos, humidity, 1);
+  appendText(line, sizeof(line), pos, "%");
+  d.updateField(opHumidity, line);
+
+  // Time elapsed (blank while heating starts and during cooldown)
+  line[0] = '\0';
+  if (elapsedSec > 0) {
+    pos = appendText(line, sizeof(line), 0, "Time:");
+    pos = appendUnsigned(line, sizeof(line), pos, (unsigned long)elapsedSec);
+    appendText(line, sizeof(line), pos, "s");
+  }
+  d.updateField(opTime, line);
+
+  d.updateField(opStatus, status);
+}
@@ -0,0 +1,32 @@
+#ifndef SCREENS_H
+#define SCREENS_H
+
+#include <Arduino.h>
+#include "FieldDisplay.h"
+#include "SensorInfo.h"
+
+// ============================================================================
+// SCREENS
+// Field layouts for the periodically refreshed screens. Each draw function
+// puts the static text down once when its screen is entered and afterwards
+// only updates the fields; the caller sends the frame with display().
+// ============================================================================
+
+enum ScreenId {
+  SCREEN_MAIN_MENU = 0,
+  SCREEN_SENSOR_INFO,
+  SCREEN_DIAGNOSTICS,
+  SCREEN_OPERATION,
+  SCREEN_MEMORY
+};
+
+#define MAIN_MENU_ITEMS 7
+
+void drawMainMenuScreen(FieldDisplay& d, uint8_t selection, const SensorInfo& s);
+void drawSensorInfoScreen(FieldDisplay& d, const SensorInfo& s);
+void drawDiagnosticsScreen(FieldDisplay& d);
+void drawMemoryScreen(FieldDisplay& d);
+void drawOperationScreen(FieldDisplay& d, const char* title, const char* status,
+                         float temp, float humidity, float tempRise, int elapsedSec);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SENSOR_INFO_H
+#define SENSOR_INFO_H
+
+#include <Arduino.h>
+#include <Psychro.h>
+
+// Sensor data
+struct SensorInfo {
+  bool connected;
+  uint8_t i2c_address;
+  uint64_t nist_id;
+  char nist_str[13];  // NIST ID as 12 hex digits, formatted once when read
+  double temperature;
+  double humidity;
+  DerivedMetrics derived;  // Dew point etc. for the latest reading
+  double temp_offset;
+  double humidity_offset;
+  bool heater_on;
+  unsigned long last_reading;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "Trace.h"
+#include "Scheduler.h"
+
+TraceBuffer traceBuffer;
+
+TraceBuffer::TraceBuffer() : head(0), count(0), dropped(0), recording(true) {
+}
+
+void TraceBuffer::clear() {
+  head = 0;
+  count = 0;
+  dropped = 0;
+}
+
+void TraceBuffer::dump(Print& out) {
+  bool wasRecording = recording;
+  recording = false;
+
+  out.print("TRACE ");
+  out.print(count);
+  out.print(" ");
+  out.println(dropped);
+
+  for (uint8_t i = 0; i < scheduler.taskCount(); i++) {
+    out.print("TRACE TASK ");
+    out.print(i);
+    out.print(" ");
+    out.println(scheduler.task(i).name);
+  }
+
+  char line[TRACE_LINE_MAX];
+  uint16_t index = (head - count) & (TRACE_CAPACITY - 1);
+  for (uint16_t i = 0; i < count; i++) {
+    formatTraceEvent(events[index], line, sizeof(line));
+    out.println(line);
+    index = (index + 1) & (TRACE_CAPACITY - 1);
+  }
+  out.println("TRACE END");
+
+  recording = wasRecording;
+}
@@ -0,0 +1,59 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include <TraceCodec.h>
+
+// ============================================================================
+// TRACE RECORDER
+// Fixed-size ring of begin / end / instant events (TraceCodec.h) with
+// micros() timestamps. Recording is a few stores, inline at the call site,
+// so it can stay on around sensor reads and display flushes; when the ring
+// is full the oldest events are overwritten. The TRACE serial command dumps
+// it, and the host converter turns the dump into a Chrome / Perfetto trace.
+// Only called from loop() context - no locking.
+// ============================================================================
+
+#define TRACE_CAPACITY 1024  // Power of two; 8 bytes each
+
+class TraceBuffer {
+public:
+  TraceBuffer();
+
+  void begin(uint8_t id, uint16_t arg = 0) { record(TRACE_BEGIN, id, arg); }
+  void end(uint8_t id, uint16_t arg = 0) { record(TRACE_END, id, arg); }
+  void instant(uint8_t id, uint16_t arg = 0) { record(TRACE_INSTANT, id, arg); }
+
+  void setEnabled(bool enable) { recording = enable; }
+  bool enabled() const { return recording; }
+  void clear();
+
+  // Oldest first, in the text format of TraceCodec.h. Not recorded itself.
+  void dump(Print& out);
+
+private:
+  void record(uint8_t phase, uint8_t id, uint16_t arg) {
+    if (!recording) return;
+    TraceEvent& e = events[head];
+    e.timeUs = micros();
+    e.phase = phase;
+    e.id = id;
+    e.arg = arg;
+    head = (head + 1) & (TRACE_CAPACITY - 1);
+    if (count < TRACE_CAPACITY) {
+      count++;
+    } else {
+      dropped++;
+    }
+  }
+
+  TraceEvent events[TRACE_CAPACITY];
+  uint16_t head;   // Next slot to write
+  uint16_t count;
+  uint32_t dropped;
+  bool recording;
+};
+
+extern TraceBuffer traceBuffer;
+
+#endif
@@ -0,0 +1,321 @@
+#include "FixtureStation.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "SerialPort.h"
+#include "TextFormat.h"
+
+#define LINE_MAX_CHARS 255
+
+static const char* STATE_NAMES[] = { "offline", "identifying", "running", "done", "no sensor" };
+
+static void logEvent(unsigned long nowMs, const std::string& station, const char* fmt, ...) {
+  printf("%8.1f [%s] ", nowMs / 1000.0, station.c_str());
+  va_list args;
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+  printf("\n");
+  fflush(stdout);
+}
+
+static const char* runCommand(MaintenanceOperation op) {
+  switch (op) {
+    case MAINT_OP_CONDENSATION: return "RUN COND";
+    case MAINT_OP_TRIAGE:       return "RUN TRIAGE";
+    case MAINT_OP_COMBINED:     return "RUN COMBINED";
+    default:                    return "RUN OFFSET";
+  }
+}
+
+FixtureStation::FixtureStation(const std::string& path, const FixtureConfig& config, ResultsDb& db)
+  : path(path), config(config), db(db), portFd(-1), currentState(STATION_OFFLINE),
+    deadline(0), lastInputMs(0), bytesRead(0), nistId(0), nextJob(0), jobFromHost(false),
+    runningOp(-1), opElapsedMs(0), lastTemp(0), lastHumidity(0), samples(0) {
+  shortName = path.compare(0, 5, "/dev/") == 0 ? path.substr(5) : path;
+}
+
+FixtureStation::~FixtureStation() {
+  if (portFd >= 0) close(portFd);
+}
+
+// ============================================================================
+// PORT
+// ============================================================================
+
+bool FixtureStation::openPort(unsigned long nowMs) {
+  portFd = serialPortOpen(path.c_str(), O_RDWR | O_NONBLOCK);
+  if (portFd < 0) return false;
+
+  lineBuffer.clear();
+  lastInputMs = nowMs;
+  setState(STATION_IDENTIFYING, nowMs);
+  send("ID", nowMs);
+  deadline = nowMs + config.replyTimeoutMs;
+  return true;
+}
+
+void FixtureStation::closePort(unsigned long nowMs, const char* why) {
+  if (portFd >= 0) close(portFd);
+  portFd = -1;
+  logEvent(nowMs, shortName, "port lost (%s)", why);
+  setState(STATION_OFFLINE, nowMs);
+  deadline = nowMs + config.reopenMs;
+}
+
+void FixtureStation::send(const char* command, unsigned long nowMs) {
+  if (portFd < 0) return;
+
+  char line[STATION_LINE_MAX];
+  int len = snprintf(line, sizeof(line), "%s\n", command);
+  if (write(portFd, line, len) != len && config.verbose) {
+    logEvent(nowMs, shortName, "short write of %s", command);
+  }
+}
+
+void FixtureStation::onReadable(unsigned long nowMs) {
+  char buf[512];
+
+  while (portFd >= 0) {
+    ssize_t n = read(portFd, buf, sizeof(buf));
+    if (n == 0) {
+      closePort(nowMs, "closed");
+      return;
+    }
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+      if (errno == EINTR) continue;
+      closePort(nowMs, strerror(errno));
+      return;
+    }
+    bytesRead += n;
+    lastInputMs = nowMs;
+
+    for (ssize_t i = 0; i < n; i++) {
+      char c = buf[i];
+      if (c == '\n') {
+        handleLine(lineBuffer.c_str(), nowMs);
+        lineBuffer.clear();
+      } else if (c != '\r' && lineBuffer.size() < LINE_MAX_CHARS) {
+        lineBuffer += c;
+      }
+    }
+  }
+}
+
+void FixtureStation::tick(unsigned long nowMs) {
+  if (nowMs < deadline) return;
+
+  switch (currentState) {
+    case STATION_OFFLINE:
+      if (!openPort(nowMs)) deadline = nowMs + config.reopenMs;
+      break;
+
+    case STATION_IDENTIFYING:
+      // Still booting (or not our firmware) - ask again
+      send("ID", nowMs);
+      deadline = nowMs + config.replyTimeoutMs;
+      break;
+
+    case STATION_RUNNING:
+      logEvent(nowMs, shortName, "no output for %lus, re-identifying",
+               (nowMs - lastInputMs) / 1000);
+      setState(STATION_IDENTIFYING, nowMs);
+      send("ID", nowMs);
+      deadline = nowMs + config.replyTimeoutMs;
+      break;
+
+    case STATION_DONE:
+    case STATION_NO_SENSOR:
+      // Has the part been swapped?
+      send("ID", nowMs);
+      deadline = nowMs + config.idPollMs;
+      break;
+  }
+}
+
+// ============================================================================
+// PROTOCOL
+// ============================================================================
+
+void FixtureStation::handleLine(const char* line, unsigned long nowMs) {
+  CaptureRecord record;
+  StationResult result;
+  uint64_t id;
+
+  if (currentState == STATION_RUNNING) deadline = nowMs + config.silenceTimeoutMs;
+
+  if (parseCaptureLine(line, record)) {
+    handleCapture(record, nowMs);
+  } else if (parseStationResult(line, result)) {
+    handleResult(result, nowMs);
+  } else if (parseStationId(line, id)) {
+    handleId(id, nowMs);
+  }
+}
+
+void FixtureStation::handleCapture(const CaptureRecord& record, unsigned long nowMs) {
+  switch (record.type) {
+    case CAP_BEGIN:
+      if (currentState != STATION_RUNNING) {
+        // Started from the station's buttons
+        jobFromHost = false;
+        setState(STATION_RUNNING, nowMs);
+        deadline = nowMs + config.silenceTimeoutMs;
+      }
+      runningOp = (int)record.a;
+      if (record.b != 0) {
+        logEvent(nowMs, shortName, "%s from a stored recipe",
+                 fixtureOperationName((MaintenanceOperation)record.a));
+      }
+      samples = 0;
+      opElapsedMs = 0;
+      break;
+
+    case CAP_READ:
+      lastTemp = captureFromMilli(record.a);
+      lastHumidity = captureFromMilli(record.b);
+      opElapsedMs = record.ms;
+      samples++;
+      if (config.verbose) {
+        logEvent(nowMs, shortName, "%6.1fs  T=%6.2f  RH=%6.2f", record.ms / 1000.0,
+                 lastTemp, lastHumidity);
+      }
+      break;
+
+    default:
+      opElapsedMs = record.ms;
+      break;
+  }
+}
+
+void FixtureStation::handleResult(const StationResult& result, unsigned long nowMs) {
+  db.add(nistId, shortName, result);
+
+  char id[13];
+  formatNistId(id, nistId);
+  if (result.operation == MAINT_OP_OFFSET_CORRECTION) {
+    logEvent(nowMs, shortName, "%s %s %s in %.1fs  RH offset %+.2f  final T=%.2f RH=%.2f",
+             id, fixtureOperationName(result.operation), result.success ? "ok" : "FAILED",
+             result.durationMs / 1000.0, result.humidityOffset, result.finalTemp,
+             result.finalHumidity);
+  } else if (result.operation == MAINT_OP_COMBINED && result.success) {
+    logEvent(nowMs, shortName, "%s combined ok in %.1fs (~%.0fs saved)  RH offset %+.2f  final T=%.2f RH=%.2f",
+             id, result.durationMs / 1000.0,
+             result.savedMs / 1000.0, result.humidityOffset, result.finalTemp, result.finalHumidity);
+  } else if (result.operation == MAINT_OP_TRIAGE) {
+    logEvent(nowMs, shortName, "%s triage %s in %.1fs  RH error %+.2f",
+             id, result.success ? triageVerdictName(result.verdict) : "FAILED",
+             result.durationMs / 1000.0, result.humidityOffset);
+  } else {
+    logEvent(nowMs, shortName, "%s %s %s in %.1fs  final T=%.2f RH=%.2f",
+             id, fixtureOperationName(result.operation), result.success ? "ok" : "FAILED",
+             result.durationMs / 1000.0, result.finalTemp, result.finalHumidity);
+  }
+  runningOp = -1;
+
+  if (!jobFromHost) {
+    // Someone ran an operation by hand - resync before carrying on
+    setState(STATION_IDENTIFYING, nowMs);
+    send("ID", nowMs);
+    deadline = nowMs + config.replyTimeoutMs;
+    return;
+  }
+
+  if (!result.success) {
+    logEvent(nowMs, shortName, "%s: job failed, remaining jobs skipped", id);
+    setState(STATION_DONE, nowMs);
+    deadline = nowMs + config.idPollMs;
+    return;
+  }
+
+  if (result.operation == MAINT_OP_TRIAGE) {
+    // Queue what the verdict asks for, unless the job list has it anyway
+    std::vector<MaintenanceOperation> followUps;
+    triageFollowUps(result.verdict, followUps);
+    size_t insertAt = nextJob + 1;
+    for (size_t i = 0; i < followUps.size(); i++) {
+      if (std::find(partJobs.begin() + insertAt, partJobs.end(), followUps[i]) == partJobs.end()) {
+        partJobs.insert(partJobs.begin() + insertAt, followUps[i]);
+        insertAt++;
+      }
+    }
+  }
+
+  nextJob++;
+  startNextJob(nowMs);
+}
+
+void FixtureStation::handleId(uint64_t id, unsigned long nowMs) {
+  if (currentState == STATION_RUNNING) return;
+
+  if (id == 0) {
+    if (currentState != STATION_NO_SENSOR) setState(STATION_NO_SENSOR, nowMs);
+    nistId = 0;
+    deadline = nowMs + config.idPollMs;
+    return;
+  }
+
+  // Same part still in the fixture
+  if (currentState == STATION_DONE && id == nistId) return;
+
+  char text[13];
+  formatNistId(text, id);
+  if (id != nistId) {
+    logEvent(nowMs, shortName, "sensor %s", text);
+    nistId = id;
+    partJobs = config.jobs;
+    nextJob = 0;
+  }
+
+  if (nextJob == 0 && !config.rerun && db.completed(id, config.jobs)) {
+    logEvent(nowMs, shortName, "%s: already done, skipped", text);
+    nextJob = partJobs.size();
+  }
+  startNextJob(nowMs);
+}
+
+void FixtureStation::startNextJob(unsigned long nowMs) {
+  if (nextJob >= partJobs.size()) {
+    setState(STATION_DONE, nowMs);
+    deadline = nowMs + config.idPollMs;
+    return;
+  }
+
+  MaintenanceOperation op = partJobs[nextJob];
+  jobFromHost = true;
+  runningOp = (int)op;
+  samples = 0;
+  opElapsedMs = 0;
+  setState(STATION_RUNNING, nowMs);
+  send(runCommand(op), nowMs);
+  deadline = nowMs + config.silenceTimeoutMs;
+}
+
+void FixtureStation::setState(StationState next, unsigned long nowMs) {
+  if (next == currentState) return;
+  currentState = next;
+  if (config.verbose || next == STATION_DONE || next == STATION_NO_SENSOR) {
+    logEvent(nowMs, shortName, "%s", STATE_NAMES[next]);
+  }
+}
+
+void FixtureStation::printStatus(FILE* out, unsigned long nowMs) const {
+  char id[13];
+  formatNistId(id, nistId);
+  fprintf(out, "  %-14s %-12s %s", shortName.c_str(), STATE_NAMES[currentState],
+          nistId != 0 ? id : "-           ");
+  if (currentState == STATION_RUNNING && runningOp >= 0) {
+    fprintf(out, "  %-12s %6.1fs  T=%6.2f RH=%6.2f  (%u samples)",
+            fixtureOperationName((MaintenanceOperation)runningOp), opElapsedMs / 1000.0,
+            lastTemp, lastHumidity, samples);
+  }
+  fprintf(out, "\n");
+}
@@ -0,0 +1,102 @@
+#ifndef FIXTURE_STATION_H
+#define FIXTURE_STATION_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "Capture.h"
+#include "ResultsDb.h"
+#include "StationProtocol.h"
+
+// ============================================================================
+// FIXTURE STATION (host only)
+// One maintenance station on a serial port (or pty), as seen by the fixture
+// daemon. All I/O is non-blocking: the daemon polls every station's fd and
+// calls onReadable() / tick(); the station never waits for anything.
+//
+//   OFFLINE -> IDENTIFYING -> RUNNING (job 1) -> ... -> DONE
+//                  ^   |                                  |
+//                  |   +-> NO_SENSOR                      |
+//                  +---------- periodic ID poll ----------+
+//
+// A sensor whose jobs have all already succeeded (results DB) goes straight
+// to DONE, so a restarted daemon doesn't redo finished parts. A triage job
+// queues the operations its verdict asks for right behind it.
+// ============================================================================
+
+enum StationState {
+  STATION_OFFLINE = 0,   // Port not open, retried periodically
+  STATION_IDENTIFYING,   // ID sent, waiting for the reply
+  STATION_RUNNING,       // Operation in progress (ours or from the buttons)
+  STATION_DONE,          // Jobs finished for this sensor
+  STATION_NO_SENSOR      // Station answered but has no readable sensor
+};
+
+struct FixtureConfig {
+  std::vector<MaintenanceOperation> jobs;  // Run in order on each new sensor
+  unsigned long idPollMs;      // ID poll while DONE / NO_SENSOR (new part?)
+  unsigned long replyTimeoutMs;
+  unsigned long silenceTimeoutMs;  // No output while RUNNING -> station lost
+  unsigned long reopenMs;
+  bool rerun;      // Ignore earlier results in the DB
+  bool verbose;    // Print every sample
+};
+
+class FixtureStation {
+public:
+  FixtureStation(const std::string& path, const FixtureConfig& config, ResultsDb& db);
+  ~FixtureStation();
+
+  // fd to poll, or -1 while offline
+  int fd() const { return portFd; }
+
+  void onReadable(unsigned long nowMs);
+  void tick(unsigned long nowMs);
+  // Next time tick() has something to do
+  unsigned long nextDeadline() const { return deadline; }
+
+  StationState state() const { return currentState; }
+  const std::string& name() const { return shortName; }
+  void printStatus(FILE* out, unsigned long nowMs) const;
+
+  unsigned long bytesIn() const { return bytesRead; }
+
+private:
+  bool openPort(unsigned long nowMs);
+  void closePort(unsigned long nowMs, const char* why);
+  void send(const char* command, unsigned long nowMs);
+  void handleLine(const char* line, unsigned long nowMs);
+  void handleCapture(const CaptureRecord& record, unsigned long nowMs);
+  void handleResult(const StationResult& result, unsigned long nowMs);
+  void handleId(uint64_t id, unsigned long nowMs);
+  void startNextJob(unsigned long nowMs);
+  void setState(StationState next, unsigned long nowMs);
+
+  std::string path;
+  std::string shortName;
+  const FixtureConfig& config;
+  ResultsDb& db;
+
+  int portFd;
+  StationState currentState;
+  unsigned long deadline;
+  unsigned long lastInputMs;
+  std::string lineBuffer;
+  unsigned long bytesRead;
+
+  uint64_t nistId;
+  std::vector<MaintenanceOperation> partJobs;  // config.jobs + triage follow-ups
+  size_t nextJob;      // Index into partJobs
+  bool jobFromHost;    // Current RUNNING operation was sent by us
+
+  // Progress of the current operation (CAP lines)
+  int runningOp;
+  unsigned long opElapsedMs;
+  double lastTemp;
+  double lastHumidity;
+  unsigned int samples;
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include "ReplayBackend.h"
+
+#include <stdio.h>
+
+// ============================================================================
+// CAPTURE LOADING
+// ============================================================================
+
+bool loadCaptureRuns(const char* path, std::vector<CaptureRun>& runs) {
+  FILE* f = fopen(path, "r");
+  if (f == NULL) return false;
+
+  char line[256];
+  CaptureRun* current = NULL;
+
+  while (fgets(line, sizeof(line), f) != NULL) {
+    CaptureRecord r;
+    if (!parseCaptureLine(line, r)) continue;
+
+    if (r.type == CAP_BEGIN) {
+      CaptureRun run;
+      run.operation = (MaintenanceOperation)r.a;
+      run.recipe = r.b != 0;
+      run.complete = false;
+      run.recordedSuccess = false;
+      run.recordedDurationMs = 0;
+      run.hasRecordedOffsets = false;
+      run.recordedTempOffset = 0.0;
+      run.recordedHumidityOffset = 0.0;
+      runs.push_back(run);
+      current = &runs.back();
+    }
+    if (current == NULL) continue;  // Records before the first B line
+
+    current->records.push_back(r);
+
+    if (r.type == CAP_OFFSET_WRITE) {
+      current->hasRecordedOffsets = true;
+      current->recordedTempOffset = captureFromMilli(r.a);
+      current->recordedHumidityOffset = captureFromMilli(r.b);
+    } else if (r.type == CAP_END) {
+      current->complete = true;
+      current->recordedSuccess = r.a != 0;
+      current->recordedDurationMs = r.ms;
+      current = NULL;
+    }
+  }
+
+  fclose(f);
+  return true;
+}
+
+// ============================================================================
+// REPLAY BACKEND
+// ============================================================================
+
+ReplayBackend::ReplayBackend(const CaptureRun& run, unsigned long maxGapMs)
+  : run(run), maxGapMs(maxGapMs), now(0), heaterPower(HDC_HEATER_OFF),
+    tempOffset(0.0), humidityOffset(0.0), outOfTrace(0), heaterDivergent(0),
+    lastReadIndex(0), lastReadNow(0), haveLastRead(false) {
+}
+
+long ReplayBackend::recordedHeaterBefore(size_t index) const {
+  long power = HDC_HEATER_OFF;
+  for (size_t i = 0; i < index; i++) {
+    if (run.records[i].type == CAP_HEATER) power = run.records[i].a;
+  }
+  return power;
+}
+
+bool ReplayBackend::readTemperatureHumidity(double& temperature, double& humidity) {
+  // Answer with the captured reading nearest in time to "now"
+  const CaptureRecord* nearest = NULL;
+  size_t nearestIndex = 0;
+  unsigned long nearestGap = 0;
+
+  for (size_t i = 0; i < run.records.size(); i++) {
+    const CaptureRecord& r = run.records[i];
+    if (r.type != CAP_READ && r.type != CAP_READ_FAIL) continue;
+
+    unsigned long gap = r.ms > now ? r.ms - now : now - r.ms;
+    if (nearest == NULL || gap < nearestGap) {
+      nearest = &r;
+      nearestIndex = i;
+      nearestGap = gap;
+    }
+  }
+
+  // A read straight after another one (no delay in between, e.g. the
+  // plateau-mode re-read at the top of a ramp) is the next captured reading
+  if (haveLastRead && now == lastReadNow) {
+    for (size_t i = lastReadIndex + 1; i < run.records.size(); i++) {
+      const CaptureRecord& r = run.records[i];
+      if (r.type != CAP_READ && r.type != CAP_READ_FAIL) continue;
+      if (r.ms >= now && r.ms - now <= maxGapMs) {
+        nearest = &r;
+        nearestIndex = i;
+        nearestGap = r.ms - now;
+      }
+      break;
+    }
+  }
+
+  if (nearest == NULL || nearestGap > maxGapMs) {
+    outOfTrace++;
+    return false;
+  }
+
+  // Conversion and bus time is part of the capture - honour it
+  if (nearest->ms > now) now = nearest->ms;
+  lastReadIndex = nearestIndex;
+  lastReadNow = now;
+  haveLastRead = true;
+
+  if (recordedHeaterBefore(nearestIndex) != heaterPower) {
+    heaterDivergent++;
+  }
+
+  if (nearest->type == CAP_READ_FAIL) return false;
+
+  temperature = captureFromMilli(nearest->a);
+  humidity = captureFromMilli(nearest->b);
+  return true;
+}
+
+bool ReplayBackend::heaterEnable(HdcHeaterPower power) {
+  heaterPower = power;
+  return true;
+}
+
+bool ReplayBackend::writeOffsets(double temp, double humidity) {
+  tempOffset = temp;
+  humidityOffset = humidity;
+  return true;
+}
+
+bool ReplayBackend::readOffsets(double& temp, double& humidity) {
+  temp = tempOffset;
+  humidity = humidityOffset;
+  return true;
+}
+
+unsigned long ReplayBackend::millis() {
+  return now;
+}
+
+void ReplayBackend::delay(unsigned long ms) {
+  now += ms;
+}
@@ -0,0 +1,65 @@
+#ifndef REPLAY_BACKEND_H
+#define REPLAY_BACKEND_H
+
+#include <vector>
+
+#include "HdcBackend.h"
+#include "Capture.h"
+
+// ============================================================================
+// REPLAY BACKEND (host only)
+// Stands in for Adafruit_HDC302x by answering reads from a captured run.
+// Time is virtual: delay() just advances the clock, so a five minute field
+// run replays in microseconds.
+// ============================================================================
+
+// One captured operation (B record through E record)
+struct CaptureRun {
+  MaintenanceOperation operation;
+  bool recipe;                 // A stored recipe ran, not the built-in procedure
+  std::vector<CaptureRecord> records;
+  bool complete;               // E record seen
+  bool recordedSuccess;
+  unsigned long recordedDurationMs;
+  bool hasRecordedOffsets;
+  double recordedTempOffset;   // As written to the sensor
+  double recordedHumidityOffset;
+};
+
+// Split a capture file into runs. Returns false if the file can't be read.
+bool loadCaptureRuns(const char* path, std::vector<CaptureRun>& runs);
+
+class ReplayBackend : public HdcBackend {
+public:
+  // Reads further than maxGapMs from any captured reading fail (out of trace)
+  explicit ReplayBackend(const CaptureRun& run, unsigned long maxGapMs = 1500);
+
+  bool readTemperatureHumidity(double& temperature, double& humidity);
+  bool heaterEnable(HdcHeaterPower power);
+  bool writeOffsets(double tempOffset, double humidityOffset);
+  bool readOffsets(double& tempOffset, double& humidityOffset);
+  unsigned long millis();
+  void delay(unsigned long ms);
+
+  // Reads requested outside the captured time span
+  unsigned int outOfTraceReads() const { return outOfTrace; }
+  // Reads taken while the heater state differed from the captured run
+  unsigned int heaterDivergentReads() const { return heaterDivergent; }
+
+private:
+  long recordedHeaterBefore(size_t index) const;
+
+  const CaptureRun& run;
+  unsigned long maxGapMs;
+  unsigned long now;
+  long heaterPower;
+  double tempOffset;
+  double humidityOffset;
+  unsigned int outOfTrace;
+  unsigned int heaterDivergent;
+  size_t lastReadIndex;   // Record answered by the previous read
+  unsigned long lastReadNow;
+  bool haveLastRead;
+};
+
+#endif
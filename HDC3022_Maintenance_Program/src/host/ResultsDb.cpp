@@ -0,0 +1,236 @@
+#include "ResultsDb.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "TextFormat.h"
+
+#define CSV_HEADER "time,nist_id,station,operation,success,duration_ms,temp_offset," \
+                   "humidity_offset,final_temp,final_rh,verdict,saved_ms"
+#define CSV_COLUMNS 12
+#define CSV_MIN_COLUMNS 10  // Rows from before the verdict column
+
+static const char* const VERDICT_NAMES[] = { "ok", "offset", "condensation" };
+
+const char* fixtureOperationName(MaintenanceOperation op) {
+  switch (op) {
+    case MAINT_OP_CONDENSATION: return "condensation";
+    case MAINT_OP_TRIAGE:       return "triage";
+    case MAINT_OP_COMBINED:     return "combined";
+    default:                    return "offset-corr";
+  }
+}
+
+static bool operationFromName(const char* name, MaintenanceOperation& op) {
+  for (int i = 0; i < MAINT_OP_COUNT; i++) {
+    if (strcmp(name, fixtureOperationName((MaintenanceOperation)i)) == 0) {
+      op = (MaintenanceOperation)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void triageFollowUps(TriageVerdict verdict, std::vector<MaintenanceOperation>& jobs) {
+  jobs.clear();
+  // A wet part is dried and corrected in one heat cycle
+  if (verdict == TRIAGE_NEEDS_CONDENSATION_REMOVAL) jobs.push_back(MAINT_OP_COMBINED);
+  if (verdict == TRIAGE_NEEDS_OFFSET_CORRECTION) jobs.push_back(MAINT_OP_OFFSET_CORRECTION);
+}
+
+static int countColumns(const char* line) {
+  int n = 1;
+  for (const char* p = strchr(line, ','); p != NULL; p = strchr(p + 1, ',')) n++;
+  return n;
+}
+
+static bool parseRow(char* line, ResultRecord& record) {
+  // Split in place on commas (no field contains one)
+  char* fields[CSV_COLUMNS];
+  int n = 0;
+  char* p = line;
+  while (n < CSV_COLUMNS) {
+    fields[n++] = p;
+    p = strchr(p, ',');
+    if (p == NULL) break;
+    *p++ = '\0';
+  }
+  if (p != NULL || n < CSV_MIN_COLUMNS) return false;
+  // Older rows leave the trailing columns out
+  for (int i = n; i < CSV_COLUMNS; i++) fields[i] = (char*)"";
+
+  char* end;
+  record.time = fields[0];
+  record.nistId = strtoull(fields[1], &end, 16);
+  if (end == fields[1]) return false;
+  record.station = fields[2];
+  if (!operationFromName(fields[3], record.result.operation)) return false;
+  record.result.success = atoi(fields[4]) != 0;
+  record.result.durationMs = strtoul(fields[5], NULL, 10);
+  record.result.tempOffset = atof(fields[6]);
+  record.result.humidityOffset = atof(fields[7]);
+  record.result.finalTemp = atof(fields[8]);
+  record.result.finalHumidity = atof(fields[9]);
+  record.result.verdict = TRIAGE_OK;
+  for (int v = 0; v < 3; v++) {
+    if (strcmp(fields[10], VERDICT_NAMES[v]) == 0) record.result.verdict = (TriageVerdict)v;
+  }
+  record.result.savedMs = strtoul(fields[11], NULL, 10);
+  return true;
+}
+
+ResultsDb::ResultsDb() : file(NULL) {
+}
+
+ResultsDb::~ResultsDb() {
+  if (file != NULL) fclose(file);
+}
+
+bool ResultsDb::open(const char* path) {
+  std::vector<std::string> rows;
+  bool upgrade = false;
+
+  FILE* in = fopen(path, "r");
+  if (in != NULL) {
+    char line[256];
+    while (fgets(line, sizeof(line), in) != NULL) {
+      line[strcspn(line, "\r\n")] = '\0';
+      if (line[0] == '\0') continue;
+      if (strncmp(line, "time,", 5) == 0) {
+        // A header - an older one means the file needs the new columns
+        if (strcmp(line, CSV_HEADER) != 0) upgrade = true;
+        continue;
+      }
+      rows.push_back(line);
+      ResultRecord record;
+      if (parseRow(line, record)) remember(record);
+    }
+    fclose(in);
+  }
+
+  if (upgrade && !rewrite(path, rows)) return false;
+
+  file = fopen(path, "a");
+  if (file == NULL) return false;
+  if (ftell(file) == 0) {
+    fprintf(file, CSV_HEADER "\n");
+    fflush(file);
+  }
+  return true;
+}
+
+// Current header, and every row padded out to the current columns
+bool ResultsDb::rewrite(const char* path, const std::vector<std::string>& rows) {
+  std::string tmpPath = std::string(path) + ".tmp";
+  FILE* out = fopen(tmpPath.c_str(), "w");
+  if (out == NULL) return false;
+
+  fprintf(out, CSV_HEADER "\n");
+  for (size_t i = 0; i < rows.size(); i++) {
+    fputs(rows[i].c_str(), out);
+    int n = countColumns(rows[i].c_str());
+    if (n >= CSV_MIN_COLUMNS) {
+      for (; n < CSV_COLUMNS; n++) fputc(',', out);
+    }
+    fputc('\n', out);
+  }
+  if (fclose(out) != 0) return false;
+  return rename(tmpPath.c_str(), path) == 0;
+}
+
+void ResultsDb::add(uint64_t nistId, const std::string& station, const StationResult& result) {
+  ResultRecord record;
+  char stamp[24];
+  time_t now = time(NULL);
+  strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+  record.time = stamp;
+  record.nistId = nistId;
+  record.station = station;
+  record.result = result;
+  remember(record);
+
+  if (file == NULL) return;
+  char id[13];
+  formatNistId(id, nistId);
+  char saved[12] = "";
+  if (result.operation == MAINT_OP_COMBINED) snprintf(saved, sizeof(saved), "%lu", result.savedMs);
+  fprintf(file, "%s,%s,%s,%s,%d,%lu,%.3f,%.3f,%.3f,%.3f,%s,%s\n",
+          record.time.c_str(), id, station.c_str(), fixtureOperationName(result.operation),
+          result.success ? 1 : 0, result.durationMs, result.tempOffset,
+          result.humidityOffset, result.finalTemp, result.finalHumidity,
+          result.operation == MAINT_OP_TRIAGE ? VERDICT_NAMES[result.verdict] : "", saved);
+  fflush(file);
+}
+
+void ResultsDb::remember(const ResultRecord& record) {
+  std::map<uint64_t, SensorHistory>::iterator it = sensors.find(record.nistId);
+  if (it == sensors.end()) {
+    SensorHistory history;
+    for (int i = 0; i < MAINT_OP_COUNT; i++) history.have[i] = false;
+    history.runs = 0;
+    it = sensors.insert(std::make_pair(record.nistId, history)).first;
+  }
+
+  SensorHistory& history = it->second;
+  history.have[record.result.operation] = true;
+  history.latest[record.result.operation] = record;
+  history.runs++;
+}
+
+bool ResultsDb::completed(uint64_t nistId, const std::vector<MaintenanceOperation>& jobs) const {
+  std::map<uint64_t, SensorHistory>::const_iterator it = sensors.find(nistId);
+  if (it == sensors.end()) return false;
+  const SensorHistory& h = it->second;
+
+  std::vector<MaintenanceOperation> needed(jobs);
+  for (size_t i = 0; i < jobs.size(); i++) {
+    if (jobs[i] != MAINT_OP_TRIAGE || !h.have[MAINT_OP_TRIAGE]) continue;
+    std::vector<MaintenanceOperation> followUps;
+    triageFollowUps(h.latest[MAINT_OP_TRIAGE].result.verdict, followUps);
+    needed.insert(needed.end(), followUps.begin(), followUps.end());
+  }
+
+  for (size_t i = 0; i < needed.size(); i++) {
+    if (!h.have[needed[i]] || !h.latest[needed[i]].result.success) return false;
+  }
+  return true;
+}
+
+void ResultsDb::printSummary(FILE* out) const {
+  fprintf(out, "%-12s %4s  %-24s %-22s %-30s %-30s\n", "nist_id", "runs", "triage", "condensation",
+          "offset-corr", "combined");
+
+  for (std::map<uint64_t, SensorHistory>::const_iterator it = sensors.begin();
+       it != sensors.end(); ++it) {
+    const SensorHistory& h = it->second;
+    char id[13];
+    formatNistId(id, it->first);
+
+    char tr[40] = "-";
+    if (h.have[MAINT_OP_TRIAGE]) {
+      const StationResult& r = h.latest[MAINT_OP_TRIAGE].result;
+      snprintf(tr, sizeof(tr), "%-12s %4.0fs %+.2f", r.success ? VERDICT_NAMES[r.verdict] : "FAIL",
+               r.durationMs / 1000.0, r.humidityOffset);
+    }
+    char cr[32] = "-";
+    if (h.have[MAINT_OP_CONDENSATION]) {
+      const StationResult& r = h.latest[MAINT_OP_CONDENSATION].result;
+      snprintf(cr, sizeof(cr), "%s %5.0fs RH=%.2f", r.success ? "ok  " : "FAIL",
+               r.durationMs / 1000.0, r.finalHumidity);
+    }
+    char oc[40] = "-";
+    if (h.have[MAINT_OP_OFFSET_CORRECTION]) {
+      const StationResult& r = h.latest[MAINT_OP_OFFSET_CORRECTION].result;
+      snprintf(oc, sizeof(oc), "%s %5.0fs offset=%+.2f%%RH", r.success ? "ok  " : "FAIL",
+               r.durationMs / 1000.0, r.humidityOffset);
+    }
+    char co[48] = "-";
+    if (h.have[MAINT_OP_COMBINED]) {
+      const StationResult& r = h.latest[MAINT_OP_COMBINED].result;
+      snprintf(co, sizeof(co), "%s %5.0fs offset=%+.2f%%RH saved=%.0fs", r.success ? "ok  " : "FAIL",
+               r.durationMs / 1000.0, r.humidityOffset, r.savedMs / 1000.0);
+    }
+    fprintf(out, "%-12s %4u  %-24s %-22s %-30s %-30s\n", id, h.runs, tr, cr, oc, co);
+  }
+}
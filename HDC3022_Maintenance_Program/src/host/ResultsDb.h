@@ -0,0 +1,73 @@
+#ifndef RESULTS_DB_H
+#define RESULTS_DB_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "StationProtocol.h"
+
+// ============================================================================
+// RESULTS DATABASE (host only)
+// Every operation result the fixture sees, keyed by sensor NIST ID. Stored
+// as an append-only CSV so it survives restarts, can be opened in a
+// spreadsheet, and several days of production can be concatenated:
+//
+//   time,nist_id,station,operation,success,duration_ms,temp_offset,
+//   humidity_offset,final_temp,final_rh,verdict,saved_ms
+//
+// For triage rows humidity_offset is the estimated RH error and verdict is
+// ok / offset / condensation. saved_ms is filled in for combined rows only.
+// A file from an older daemon (fewer columns) is rewritten with the current
+// header when opened.
+// ============================================================================
+
+struct ResultRecord {
+  std::string time;     // UTC, ISO 8601
+  uint64_t nistId;
+  std::string station;
+  StationResult result;
+};
+
+// Latest result per operation for one sensor
+struct SensorHistory {
+  bool have[MAINT_OP_COUNT];
+  ResultRecord latest[MAINT_OP_COUNT];  // Indexed by MaintenanceOperation
+  unsigned int runs;
+};
+
+class ResultsDb {
+public:
+  ResultsDb();
+  ~ResultsDb();
+
+  // Load the existing rows and open the file for appending
+  bool open(const char* path);
+
+  // Record a result (written through to the file immediately)
+  void add(uint64_t nistId, const std::string& station, const StationResult& result);
+
+  // True if the latest run of every job for this sensor succeeded (for
+  // triage: and so did the latest run of each follow-up it asked for)
+  bool completed(uint64_t nistId, const std::vector<MaintenanceOperation>& jobs) const;
+
+  size_t sensorCount() const { return sensors.size(); }
+  void printSummary(FILE* out) const;
+
+private:
+  void remember(const ResultRecord& record);
+  bool rewrite(const char* path, const std::vector<std::string>& rows);
+
+  FILE* file;
+  std::map<uint64_t, SensorHistory> sensors;
+};
+
+const char* fixtureOperationName(MaintenanceOperation op);
+
+// Operations a triage verdict calls for, in the order to run them
+void triageFollowUps(TriageVerdict verdict, std::vector<MaintenanceOperation>& jobs);
+
+#endif
@@ -0,0 +1,26 @@
+#include "SerialPort.h"
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+int serialPortOpen(const char* path, int flags) {
+  int fd = open(path, flags | O_NOCTTY);
+  if (fd < 0 || !isatty(fd)) return fd;
+
+  struct termios tio;
+  tcgetattr(fd, &tio);
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, B115200);  // Ignored by USB CDC, required by termios
+  cfsetospeed(&tio, B115200);
+  tio.c_cflag |= CLOCAL | CREAD;
+  tcsetattr(fd, TCSANOW, &tio);
+  tcflush(fd, TCIOFLUSH);  // Drop whatever the station sent before we looked
+  return fd;
+}
+
+int serialInputOpen(const char* path) {
+  int fd = serialPortOpen(path, O_RDWR);
+  if (fd < 0) fd = open(path, O_RDONLY);
+  return fd;
+}
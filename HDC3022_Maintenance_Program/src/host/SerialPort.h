@@ -0,0 +1,20 @@
+#ifndef SERIAL_PORT_H
+#define SERIAL_PORT_H
+
+// ============================================================================
+// STATION SERIAL PORT (host only)
+// Opening a station's USB serial port for the host tools: raw bytes, no
+// echo or line editing, and not the controlling terminal. A path that isn't
+// a tty (a saved serial log, a pipe, a pseudo-terminal's file) is opened
+// as is.
+// ============================================================================
+
+// open() with O_NOCTTY added; flags as for open (O_RDWR, O_NONBLOCK, ...).
+// Returns the fd, or -1 with errno set.
+int serialPortOpen(const char* path, int flags);
+
+// A port to talk to, or a saved log to read: read-write if possible,
+// otherwise read-only. Returns the fd, or -1 with errno set.
+int serialInputOpen(const char* path);
+
+#endif
@@ -0,0 +1,110 @@
+#include "SimulatedHdc.h"
+
+#include <math.h>
+
+#include "SensorCodec.h"
+
+const unsigned long SIM_CONVERSION_MS[HDC_MODE_COUNT] = { 12, 8, 5, 4 };
+const double SIM_NOISE_SCALE[HDC_MODE_COUNT] = { 1.0, 1.5, 2.0, 3.0 };
+
+double simSaturationPressure(double temperature) {
+  return 6.112 * exp(17.62 * temperature / (243.12 + temperature));
+}
+
+// Heater power scales with the number of enabled heater segments (14 max)
+static double heaterRiseFor(HdcHeaterPower power) {
+  int bits = 0;
+  for (unsigned int w = (unsigned int)power; w != 0; w >>= 1) {
+    bits += w & 1;
+  }
+  return SIM_FULL_POWER_RISE * bits / 14.0;
+}
+
+SimulatedHdc::SimulatedHdc(const SimConditions& conditions)
+  : cond(conditions), now(0), integrated(0), dieTemp(conditions.ambientTemp),
+    condensate(conditions.condensate), heaterRise(0.0), tempOffset(0.0),
+    humidityOffset(0.0), mode(HDC_MODE_LP0), rng(conditions.seed ? conditions.seed : 1) {
+  vapourPressure = simSaturationPressure(cond.ambientTemp) * cond.ambientHumidity / 100.0;
+}
+
+double SimulatedHdc::trueHumidity() const {
+  if (condensate > 0.0) return 100.0;
+  double rh = 100.0 * vapourPressure / simSaturationPressure(dieTemp);
+  return rh > 100.0 ? 100.0 : rh;
+}
+
+void SimulatedHdc::advance(unsigned long ms) {
+  now += ms;
+
+  const double dt = SIM_STEP_MS / 1000.0;
+  const double alpha = 1.0 - exp(-dt / SIM_TIME_CONSTANT_S);
+
+  while (integrated + SIM_STEP_MS <= now) {
+    integrated += SIM_STEP_MS;
+
+    double target = cond.ambientTemp + heaterRise;
+    dieTemp += (target - dieTemp) * alpha;
+
+    if (condensate > 0.0) {
+      double deficit = simSaturationPressure(dieTemp) - vapourPressure;
+      if (deficit > 0.0) {
+        condensate -= SIM_EVAPORATION_RATE * deficit * dt;
+        if (condensate < 0.0) condensate = 0.0;
+      }
+    }
+  }
+}
+
+// Box-Muller on a xorshift32 stream - deterministic per seed
+double SimulatedHdc::noise(double sigma) {
+  if (sigma <= 0.0) return 0.0;
+
+  rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+  double u1 = (rng + 1.0) / 4294967297.0;
+  rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+  double u2 = (rng + 1.0) / 4294967297.0;
+
+  return sigma * sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+bool SimulatedHdc::readTemperatureHumidity(double& temperature, double& humidity) {
+  advance(SIM_CONVERSION_MS[mode]);
+
+  double scale = SIM_NOISE_SCALE[mode];
+  double t = dieTemp + tempOffset + noise(cond.tempNoise * scale);
+  double rh = trueHumidity() + cond.humidityDrift + humidityOffset + noise(cond.humidityNoise * scale);
+
+  // Through the sensor's 16-bit codes (quantised, clamped to its range)
+  temperature = hdcTemperatureFromCode(hdcTemperatureToCode(t));
+  humidity = hdcHumidityFromCode(hdcHumidityToCode(rh));
+  return true;
+}
+
+bool SimulatedHdc::heaterEnable(HdcHeaterPower power) {
+  heaterRise = heaterRiseFor(power);
+  return true;
+}
+
+bool SimulatedHdc::writeOffsets(double temp, double humidity) {
+  tempOffset = temp;
+  humidityOffset = humidity;
+  return true;
+}
+
+bool SimulatedHdc::readOffsets(double& temp, double& humidity) {
+  temp = tempOffset;
+  humidity = humidityOffset;
+  return true;
+}
+
+void SimulatedHdc::setMeasureMode(HdcMeasureMode m) {
+  mode = m;
+}
+
+unsigned long SimulatedHdc::millis() {
+  return now;
+}
+
+void SimulatedHdc::delay(unsigned long ms) {
+  advance(ms);
+}
@@ -0,0 +1,79 @@
+#ifndef SIMULATED_HDC_H
+#define SIMULATED_HDC_H
+
+#include <stdint.h>
+
+#include "HdcBackend.h"
+
+// ============================================================================
+// SIMULATED HDC302x (host only)
+// A lumped thermal / moisture model of the sensor die:
+//   - die temperature relaxes toward ambient + heater rise (first order)
+//   - water vapour pressure is fixed by the ambient T/RH
+//   - a condensate film pins RH at 100% until it has evaporated
+//   - the sensor reads RH with a drift error that offset correction should
+//     cancel, plus Gaussian noise on both channels
+// Time is virtual, like the replay backend.
+// ============================================================================
+
+struct SimConditions {
+  double ambientTemp;      // C
+  double ambientHumidity;  // %RH
+  double humidityDrift;    // Sensor RH error before correction (%RH)
+  double condensate;       // Water film (arbitrary units, 0 = dry)
+  double tempNoise;        // 1-sigma C
+  double humidityNoise;    // 1-sigma %RH
+  uint32_t seed;
+};
+
+// Model constants
+#define SIM_TIME_CONSTANT_S 15.0     // Die thermal time constant
+#define SIM_FULL_POWER_RISE 120.0    // Steady-state rise at full heater power (C)
+#define SIM_EVAPORATION_RATE 0.02    // Film units per second per hPa of deficit
+#define SIM_STEP_MS 100              // Integration step
+
+// Per conversion mode (LP0..LP3): conversion time and noise relative to
+// SimConditions' 1-sigma figures (which are for LP0). Rough figures - check
+// them against the MODES TEST output of a real unit.
+extern const unsigned long SIM_CONVERSION_MS[HDC_MODE_COUNT];
+extern const double SIM_NOISE_SCALE[HDC_MODE_COUNT];
+
+// Saturation vapour pressure (hPa), Magnus formula
+double simSaturationPressure(double temperature);
+
+class SimulatedHdc : public HdcBackend {
+public:
+  explicit SimulatedHdc(const SimConditions& conditions);
+
+  bool readTemperatureHumidity(double& temperature, double& humidity);
+  bool heaterEnable(HdcHeaterPower power);
+  bool writeOffsets(double tempOffset, double humidityOffset);
+  bool readOffsets(double& tempOffset, double& humidityOffset);
+  void setMeasureMode(HdcMeasureMode mode);
+  unsigned long millis();
+  void delay(unsigned long ms);
+
+  // Ground truth for scoring
+  double dieTemperature() const { return dieTemp; }
+  double trueHumidity() const;
+  double remainingCondensate() const { return condensate; }
+  const SimConditions& conditions() const { return cond; }
+
+private:
+  void advance(unsigned long ms);
+  double noise(double sigma);
+
+  SimConditions cond;
+  double vapourPressure;
+  unsigned long now;
+  unsigned long integrated;
+  double dieTemp;
+  double condensate;
+  double heaterRise;
+  double tempOffset;
+  double humidityOffset;
+  HdcMeasureMode mode;
+  uint32_t rng;
+};
+
+#endif
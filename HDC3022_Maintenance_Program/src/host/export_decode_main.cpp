@@ -0,0 +1,269 @@
+// ============================================================================
+// HDC SAMPLE LOG EXPORT DECODER (host)
+// Pulls the sample log from a maintenance unit over USB (or decodes a saved
+// raw capture of an export) and writes CSV.
+//
+//   pio run -e native_export
+//   .pio/build/native_export/program /dev/ttyACM0 -o unit7.csv
+//   .pio/build/native_export/program /dev/ttyACM0 --from 86400 -o rest.csv
+//   .pio/build/native_export/program export.bin -o unit7.csv
+//
+// On a serial port a chunk that fails its CRC (or stalls) is re-requested
+// with EXPORT <next seq>, so a glitch never costs more than one chunk.
+// ============================================================================
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "LogCodec.h"
+#include "Maintenance.h"
+#include "Psychro.h"
+#include "SerialPort.h"
+
+#define READ_TIMEOUT_MS 3000
+#define MAX_RETRIES 5
+
+// ============================================================================
+// INPUT
+// ============================================================================
+
+static int inputFd = -1;
+static bool inputIsTty = false;
+
+static bool openInput(const char* path) {
+  inputFd = serialInputOpen(path);
+  if (inputFd < 0) return false;
+  inputIsTty = isatty(inputFd);
+  return true;
+}
+
+// Read exactly len bytes; false on EOF or timeout
+static bool readExact(uint8_t* buf, size_t len) {
+  size_t got = 0;
+  while (got < len) {
+    struct pollfd pfd;
+    pfd.fd = inputFd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, READ_TIMEOUT_MS) <= 0) return false;
+
+    ssize_t n = read(inputFd, buf + got, len - got);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) continue;
+      return false;
+    }
+    got += n;
+  }
+  return true;
+}
+
+// Skip text until an "EXPORT <first> <count>" line
+static bool readExportHeader(uint32_t& first, uint32_t& count) {
+  char line[128];
+  size_t len = 0;
+  uint8_t c;
+
+  while (readExact(&c, 1)) {
+    if (c == '\n') {
+      line[len] = '\0';
+      unsigned long f, n;
+      if (sscanf(line, "EXPORT %lu %lu", &f, &n) == 2) {
+        first = f;
+        count = n;
+        return true;
+      }
+      len = 0;
+    } else if (c != '\r' && len < sizeof(line) - 1) {
+      line[len++] = (char)c;
+    }
+  }
+  return false;
+}
+
+static void requestExport(uint32_t fromSeq) {
+  if (!inputIsTty) return;
+
+  char cmd[32];
+  int n = snprintf(cmd, sizeof(cmd), "EXPORT %lu\n", (unsigned long)fromSeq);
+  tcflush(inputFd, TCIFLUSH);
+  if (write(inputFd, cmd, n) != n) {
+    fprintf(stderr, "Failed to send EXPORT command\n");
+  }
+}
+
+static uint16_t getU16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// ============================================================================
+// CHUNK DECODING
+// ============================================================================
+
+enum ChunkStatus { CHUNK_OK, CHUNK_END, CHUNK_BAD, CHUNK_LOST };
+
+static ChunkStatus readChunk(uint32_t& firstSeq, std::vector<LogRecord>& records) {
+  static uint8_t chunk[LOG_CHUNK_MAX_SIZE];
+  static uint8_t raw[LOG_CHUNK_MAX_RAW];
+
+  // Resynchronise on the magic bytes
+  uint8_t prev = 0, c;
+  for (;;) {
+    if (!readExact(&c, 1)) return CHUNK_LOST;
+    if (prev == LOG_CHUNK_MAGIC0 && c == LOG_CHUNK_MAGIC1) break;
+    prev = c;
+  }
+  chunk[0] = LOG_CHUNK_MAGIC0;
+  chunk[1] = LOG_CHUNK_MAGIC1;
+
+  if (!readExact(chunk + 2, LOG_CHUNK_HEADER_SIZE - 2)) return CHUNK_LOST;
+  uint16_t payloadLen = getU16(chunk + 8);
+  if (payloadLen > LOG_CHUNK_MAX_PAYLOAD) return CHUNK_BAD;
+
+  size_t size = LOG_CHUNK_HEADER_SIZE + payloadLen + LOG_CHUNK_CRC_SIZE;
+  if (!readExact(chunk + LOG_CHUNK_HEADER_SIZE, payloadLen + LOG_CHUNK_CRC_SIZE)) return CHUNK_LOST;
+
+  size_t count;
+  records.resize(LOG_CHUNK_MAX_RECORDS);
+  if (!logParseChunk(chunk, size, raw, firstSeq, &records[0], count)) return CHUNK_BAD;
+  records.resize(count);
+  return count == 0 ? CHUNK_END : CHUNK_OK;
+}
+
+// ============================================================================
+// CSV
+// ============================================================================
+
+static void writeCsvHeader(FILE* out) {
+  fprintf(out, "seq,boot,uptime_s,type,temperature_c,humidity_pct,"
+               "operation,success,duration_s,humidity_offset_pct,"
+               "dew_point_c,abs_humidity_gm3,condensation_margin_c\n");
+}
+
+static void writeCsvRecord(FILE* out, uint32_t seq, const LogRecord& r, const DerivedMetrics& m) {
+  if (r.type == LOG_SAMPLE) {
+    fprintf(out, "%lu,%u,%lu,sample,%.2f,%.2f,,,,,%.2f,%.2f,%.2f\n",
+            (unsigned long)seq, r.boot, (unsigned long)r.uptimeSec, r.a / 100.0, r.b / 100.0,
+            m.dewPoint, m.absoluteHumidity, m.margin);
+  } else if (r.type == LOG_OPERATION) {
+    static const char* const TRIAGE_NAMES[] = { "triage_ok", "triage_offset", "triage_condensation", "triage" };
+    uint8_t op = r.flags & LOG_OPERATION_MASK;
+    uint8_t verdict = (r.flags >> LOG_VERDICT_SHIFT) & 0x03;
+    const char* name = op == MAINT_OP_CONDENSATION ? "condensation" :
+                       op == MAINT_OP_OFFSET_CORRECTION ? "offset_correction" :
+                       op == MAINT_OP_TRIAGE ? TRIAGE_NAMES[verdict] :
+                       op == MAINT_OP_COMBINED ? "combined" : "other";
+    fprintf(out, "%lu,%u,%lu,operation,,,%s,%d,%d,%.2f,,,\n",
+            (unsigned long)seq, r.boot, (unsigned long)r.uptimeSec, name,
+            (r.flags & LOG_FLAG_SUCCESS) ? 1 : 0, r.a, r.b / 100.0);
+  } else {
+    fprintf(out, "%lu,%u,%lu,unknown,,,,,,,,,\n", (unsigned long)seq, r.boot, (unsigned long)r.uptimeSec);
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* inputPath = NULL;
+  const char* outputPath = NULL;
+  uint32_t fromSeq = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      outputPath = argv[++i];
+    } else if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+      fromSeq = strtoul(argv[++i], NULL, 10);
+    } else if (argv[i][0] != '-' && inputPath == NULL) {
+      inputPath = argv[i];
+    } else {
+      inputPath = NULL;
+      break;
+    }
+  }
+
+  if (inputPath == NULL) {
+    fprintf(stderr, "usage: export_decode <port|export.bin> [--from seq] [-o out.csv]\n");
+    return 2;
+  }
+  if (!openInput(inputPath)) {
+    fprintf(stderr, "Cannot open %s\n", inputPath);
+    return 2;
+  }
+
+  FILE* out = outputPath != NULL ? fopen(outputPath, "w") : stdout;
+  if (out == NULL) {
+    fprintf(stderr, "Cannot write %s\n", outputPath);
+    return 2;
+  }
+  writeCsvHeader(out);
+
+  uint32_t nextSeq = fromSeq;
+  unsigned long exported = 0;
+  int retries = 0;
+  bool done = false;
+  bool needHeader = true;
+  std::vector<LogRecord> records;
+  std::vector<float> temps, hums;
+  std::vector<DerivedMetrics> metrics;
+
+  requestExport(nextSeq);
+
+  while (!done) {
+    if (needHeader) {
+      uint32_t first, count;
+      if (!readExportHeader(first, count)) {
+        fprintf(stderr, "No EXPORT header received\n");
+        break;
+      }
+      // The oldest records may have been overwritten since the last request
+      if (first > nextSeq) nextSeq = first;
+      fprintf(stderr, "Exporting %lu records from %lu\n", (unsigned long)count, (unsigned long)first);
+      needHeader = false;
+    }
+
+    uint32_t chunkSeq = nextSeq;
+    ChunkStatus status = readChunk(chunkSeq, records);
+
+    if (status == CHUNK_OK && chunkSeq == nextSeq) {
+      // Derived metrics for the whole chunk in one pass (only used for samples)
+      size_t n = records.size();
+      temps.resize(n);
+      hums.resize(n);
+      metrics.resize(n);
+      for (size_t i = 0; i < n; i++) {
+        temps[i] = records[i].a / 100.0f;
+        hums[i] = records[i].b / 100.0f;
+      }
+      if (n > 0) computeDerivedMetricsBatch(&temps[0], &hums[0], &metrics[0], n);
+
+      for (size_t i = 0; i < n; i++) {
+        writeCsvRecord(out, nextSeq + i, records[i], metrics[i]);
+      }
+      nextSeq += records.size();
+      exported += records.size();
+      retries = 0;
+      continue;
+    }
+    if (status == CHUNK_END) {
+      done = true;
+      continue;
+    }
+
+    // Corrupt, out of sequence or stalled - resume from the last good record
+    fprintf(stderr, "Chunk at %lu %s, resuming from %lu\n", (unsigned long)chunkSeq,
+            status == CHUNK_LOST ? "lost" : "corrupt", (unsigned long)nextSeq);
+    if (!inputIsTty || ++retries > MAX_RETRIES) break;
+    requestExport(nextSeq);
+    needHeader = true;
+  }
+
+  if (out != stdout) fclose(out);
+  close(inputFd);
+
+  fprintf(stderr, "%lu records written, next seq %lu%s\n", exported, (unsigned long)nextSeq,
+          done ? "" : " - INCOMPLETE, rerun with --from to resume");
+  return done ? 0 : 1;
+}
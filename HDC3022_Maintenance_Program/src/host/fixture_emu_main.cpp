@@ -0,0 +1,283 @@
+// ============================================================================
+// HDC MAINTENANCE STATION EMULATOR (host)
+// Stands in for a row of maintenance stations so the fixture daemon can be
+// tested without hardware. Each emulated station is a pty pair running the
+// lib/HdcCore algorithms against the simulated sensor, speaking the station
+// protocol (StationProtocol.h) with the same CAP and RESULT lines as the
+// firmware.
+//
+//   pio run -e native_fixture_emu
+//   .pio/build/native_fixture_emu/program [-n stations] [--parts n]
+//                                         [--speed x] [--seed s] > ports.txt &
+//   .pio/build/native_fixture/program --until-empty $(cat ports.txt)
+//
+// The pty paths are printed one per line. Operations run --speed times
+// faster than real time (default 20); the reported durations are the
+// simulated ones. After an operation, the next ID command finds a new part
+// in the fixture, until --parts parts (default 1) have been through; then
+// the station reports no sensor. Runs until interrupted.
+// ============================================================================
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Capture.h"
+#include "Maintenance.h"
+#include "SimulatedHdc.h"
+#include "StationProtocol.h"
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) {
+  stopRequested = 1;
+}
+
+static void writeLine(int fd, const char* line) {
+  std::string out(line);
+  out += "\r\n";  // Serial.println()
+  if (write(fd, out.data(), out.size()) < 0) {
+    // Nobody listening - same as an unplugged USB cable
+  }
+}
+
+// Simulated sensor in (scaled) real time, so the daemon sees realistic pacing
+class PacedHdc : public HdcBackend {
+public:
+  PacedHdc(SimulatedHdc& sim, double speed) : sim(sim), speed(speed) {}
+
+  bool readTemperatureHumidity(double& t, double& rh) { return sim.readTemperatureHumidity(t, rh); }
+  bool heaterEnable(HdcHeaterPower power) { return sim.heaterEnable(power); }
+  bool writeOffsets(double t, double rh) { return sim.writeOffsets(t, rh); }
+  bool readOffsets(double& t, double& rh) { return sim.readOffsets(t, rh); }
+  void setMeasureMode(HdcMeasureMode mode) { sim.setMeasureMode(mode); }
+  unsigned long millis() { return sim.millis(); }
+
+  void delay(unsigned long ms) {
+    sim.delay(ms);
+    usleep((useconds_t)(ms * 1000.0 / speed));
+  }
+
+private:
+  SimulatedHdc& sim;
+  double speed;
+};
+
+class PtySink : public CaptureSink {
+public:
+  explicit PtySink(int fd) : fd(fd) {}
+  void writeLine(const char* line) { ::writeLine(fd, line); }
+
+private:
+  int fd;
+};
+
+class PtyObserver : public MaintenanceObserver {
+public:
+  explicit PtyObserver(int fd) : fd(fd) {}
+  void onMessage(const char* message) { writeLine(fd, message); }
+
+private:
+  int fd;
+};
+
+// ============================================================================
+// STATION
+// ============================================================================
+
+struct EmuStation {
+  int master;
+  int slave;  // Held open so the master survives the daemon reconnecting
+  std::string slavePath;
+  uint64_t nistBase;
+  unsigned int partsLeft;
+  double speed;
+  uint32_t rng;
+};
+
+static double uniform(uint32_t& rng, double lo, double hi) {
+  rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+  return lo + (hi - lo) * (rng / 4294967296.0);
+}
+
+// A fresh part: random ambient, drift, and sometimes a soaked sensor
+static SimConditions newPart(uint32_t& rng) {
+  SimConditions c;
+  c.ambientTemp = uniform(rng, 18.0, 32.0);
+  c.ambientHumidity = uniform(rng, 15.0, 60.0);
+  c.humidityDrift = uniform(rng, -3.0, 3.0);
+  c.condensate = uniform(rng, 0.0, 1.0) < 0.5 ? uniform(rng, 0.5, 3.0) : 0.0;
+  c.tempNoise = 0.05;
+  c.humidityNoise = 0.1;
+  c.seed = rng;
+  return c;
+}
+
+static void runOperation(EmuStation& st, SimulatedHdc& sim, MaintenanceOperation op) {
+  PacedHdc paced(sim, st.speed);
+  PtySink sink(st.master);
+  PtyObserver observer(st.master);
+  RecordingBackend recorder(paced, sink);
+  MaintenanceResult result;
+  StationResult station;
+  bool success;
+
+  recorder.begin(op);
+  if (op == MAINT_OP_CONDENSATION) {
+    writeLine(st.master, "\n=== Starting Condensation Removal ===");
+    success = maintenanceCondensationRemoval(recorder, DEFAULT_CONDENSATION_PARAMS, observer, result);
+    stationResultFrom(op, result, station);
+  } else if (op == MAINT_OP_TRIAGE) {
+    writeLine(st.master, "\n=== Starting Quick Triage ===");
+    TriageResult triage;
+    success = maintenanceTriage(recorder, DEFAULT_TRIAGE_PARAMS, observer, result, triage);
+    stationResultFromTriage(result, triage, station);
+  } else if (op == MAINT_OP_COMBINED) {
+    writeLine(st.master, "\n=== Starting Combined Dry + Offset Correction ===");
+    CombinedResult combined;
+    success = maintenanceCombined(recorder, DEFAULT_CONDENSATION_PARAMS, DEFAULT_OFFSET_PARAMS,
+                                  observer, result, combined);
+    stationResultFromCombined(result, combined, station);
+  } else {
+    writeLine(st.master, "\n=== Starting Offset Error Correction ===");
+    success = maintenanceOffsetCorrection(recorder, DEFAULT_OFFSET_PARAMS, observer, result);
+    stationResultFrom(op, result, station);
+  }
+  recorder.end(success);
+
+  char line[STATION_LINE_MAX];
+  formatStationResult(station, line, sizeof(line));
+  writeLine(st.master, line);
+}
+
+static void stationThread(EmuStation* st) {
+  uint64_t partNumber = 0;
+  SimulatedHdc* sim = new SimulatedHdc(newPart(st->rng));
+  unsigned int opsOnPart = 0;
+  bool present = true;
+
+  writeLine(st->master, "\n=== HDC Sensor Maintenance Utility ===");
+
+  std::string command;
+  char c;
+  while (read(st->master, &c, 1) == 1) {
+    if (c != '\n' && c != '\r') {
+      if (command.size() < 31) command += c;
+      continue;
+    }
+    if (command.empty()) continue;
+
+    char line[STATION_LINE_MAX];
+    if (command == "ID") {
+      if (present && opsOnPart > 0) {
+        // The operator has swapped the part
+        delete sim;
+        sim = NULL;
+        opsOnPart = 0;
+        present = --st->partsLeft > 0;
+        if (present) {
+          partNumber++;
+          sim = new SimulatedHdc(newPart(st->rng));
+        }
+      }
+      formatStationId(present ? st->nistBase + partNumber : 0, line, sizeof(line));
+      writeLine(st->master, line);
+    } else if (command == "RUN COND" && present) {
+      runOperation(*st, *sim, MAINT_OP_CONDENSATION);
+      opsOnPart++;
+    } else if (command == "RUN OFFSET" && present) {
+      runOperation(*st, *sim, MAINT_OP_OFFSET_CORRECTION);
+      opsOnPart++;
+    } else if (command == "RUN TRIAGE" && present) {
+      runOperation(*st, *sim, MAINT_OP_TRIAGE);
+      opsOnPart++;
+    } else if (command == "RUN COMBINED" && present) {
+      runOperation(*st, *sim, MAINT_OP_COMBINED);
+      opsOnPart++;
+    } else {
+      snprintf(line, sizeof(line), "Unknown command: %s", command.c_str());
+      writeLine(st->master, line);
+    }
+    command.clear();
+  }
+  delete sim;
+}
+
+static bool openStation(EmuStation& st) {
+  st.master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (st.master < 0 || grantpt(st.master) != 0 || unlockpt(st.master) != 0) return false;
+
+  st.slavePath = ptsname(st.master);
+  st.slave = open(st.slavePath.c_str(), O_RDWR | O_NOCTTY);
+  if (st.slave < 0) return false;
+
+  // Raw from the start - an echoing line discipline would feed the
+  // station its own output as commands
+  struct termios tio;
+  tcgetattr(st.slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(st.slave, TCSANOW, &tio);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned int count = 4;
+  unsigned int parts = 1;
+  double speed = 20.0;
+  uint32_t seed = 1;
+
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "-n") == 0 && hasValue) {
+      count = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--parts") == 0 && hasValue) {
+      parts = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--speed") == 0 && hasValue) {
+      speed = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+      seed = strtoul(argv[++i], NULL, 10);
+    } else {
+      fprintf(stderr, "usage: fixture_emu [-n stations] [--parts n] [--speed x] [--seed s]\n");
+      return 2;
+    }
+  }
+  if (count == 0 || parts == 0 || speed <= 0.0) {
+    fprintf(stderr, "-n, --parts and --speed must be positive\n");
+    return 2;
+  }
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+
+  std::vector<EmuStation> stations(count);
+  for (unsigned int i = 0; i < count; i++) {
+    EmuStation& st = stations[i];
+    if (!openStation(st)) {
+      perror("pty");
+      return 1;
+    }
+    // "TI" + seed + station, parts counting up from there
+    st.nistBase = 0x544900000000ULL | ((uint64_t)(seed & 0xFF) << 24) | ((uint64_t)i << 12);
+    st.partsLeft = parts;
+    st.speed = speed;
+    st.rng = (seed * 2654435761u) ^ ((i + 1) * 40503u);
+    if (st.rng == 0) st.rng = 1;
+    printf("%s\n", st.slavePath.c_str());
+  }
+  fflush(stdout);
+
+  for (unsigned int i = 0; i < count; i++) {
+    std::thread(stationThread, &stations[i]).detach();
+  }
+
+  while (!stopRequested) pause();
+  return 0;
+}
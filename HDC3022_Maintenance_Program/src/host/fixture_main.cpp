@@ -0,0 +1,221 @@
+// ============================================================================
+// HDC MAINTENANCE FIXTURE DAEMON (host)
+// Drives any number of maintenance stations over their USB serial ports from
+// one process: identifies the sensor in each station, runs the job list on
+// every new part, follows progress from the CAP lines and records each
+// result by NIST ID (ResultsDb.h).
+//
+//   pio run -e native_fixture
+//   .pio/build/native_fixture/program [options] /dev/ttyACM0 /dev/ttyACM1 ...
+//
+//   --jobs cond,offset   operations per part, in order   (default offset)
+//                        triage = quick check, then only what it finds needed
+//                        combined = dry + offset correction in one heat cycle
+//   --db <file>          results CSV                       (default fixture_results.csv)
+//   --poll-ms <ms>       ID poll for a swapped part        (default 5000)
+//   --status-s <s>       status table interval, 0 = off    (default 30)
+//   --rerun              run parts the DB already has as done
+//   --until-empty        exit once no station has a sensor
+//   -v                   print state changes and every sample
+//
+// Single-threaded: one poll() over all ports, woken by input or by the next
+// station deadline, so dozens of stations cost next to no CPU. For a bench
+// test without hardware, run fixture_emu and pass it the pty paths it prints.
+// ============================================================================
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include <vector>
+
+#include "FixtureStation.h"
+#include "ResultsDb.h"
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) {
+  stopRequested = 1;
+}
+
+static unsigned long monotonicMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static bool parseJobs(const char* list, std::vector<MaintenanceOperation>& jobs) {
+  jobs.clear();
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%s", list);
+
+  for (char* job = strtok(buf, ","); job != NULL; job = strtok(NULL, ",")) {
+    if (strcmp(job, "cond") == 0) {
+      jobs.push_back(MAINT_OP_CONDENSATION);
+    } else if (strcmp(job, "offset") == 0) {
+      jobs.push_back(MAINT_OP_OFFSET_CORRECTION);
+    } else if (strcmp(job, "triage") == 0) {
+      jobs.push_back(MAINT_OP_TRIAGE);
+    } else if (strcmp(job, "combined") == 0) {
+      jobs.push_back(MAINT_OP_COMBINED);
+    } else {
+      return false;
+    }
+  }
+  return !jobs.empty();
+}
+
+static void usage() {
+  fprintf(stderr, "usage: fixture [--jobs triage,cond,offset,combined] [--db file] [--poll-ms ms] "
+                  "[--status-s s] [--rerun] [--until-empty] [-v] port [...]\n");
+}
+
+static void printStatus(const std::vector<FixtureStation*>& stations, unsigned long nowMs) {
+  printf("%8.1f status\n", nowMs / 1000.0);
+  for (size_t i = 0; i < stations.size(); i++) {
+    stations[i]->printStatus(stdout, nowMs);
+  }
+  fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+  FixtureConfig config;
+  config.jobs.push_back(MAINT_OP_OFFSET_CORRECTION);
+  config.idPollMs = 5000;
+  config.replyTimeoutMs = 3000;
+  config.silenceTimeoutMs = 60000;  // Longest quiet stretch in an operation is the cooldown
+  config.reopenMs = 2000;
+  config.rerun = false;
+  config.verbose = false;
+
+  const char* dbPath = "fixture_results.csv";
+  unsigned long statusMs = 30000;
+  bool untilEmpty = false;
+  std::vector<const char*> ports;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (strcmp(arg, "--jobs") == 0 && hasValue) {
+      if (!parseJobs(argv[++i], config.jobs)) {
+        fprintf(stderr, "--jobs: expected a list of triage / cond / offset / combined\n");
+        return 2;
+      }
+    } else if (strcmp(arg, "--db") == 0 && hasValue) {
+      dbPath = argv[++i];
+    } else if (strcmp(arg, "--poll-ms") == 0 && hasValue) {
+      config.idPollMs = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(arg, "--status-s") == 0 && hasValue) {
+      statusMs = strtoul(argv[++i], NULL, 10) * 1000;
+    } else if (strcmp(arg, "--rerun") == 0) {
+      config.rerun = true;
+    } else if (strcmp(arg, "--until-empty") == 0) {
+      untilEmpty = true;
+    } else if (strcmp(arg, "-v") == 0) {
+      config.verbose = true;
+    } else if (arg[0] == '-') {
+      usage();
+      return 2;
+    } else {
+      ports.push_back(arg);
+    }
+  }
+
+  if (ports.empty()) {
+    usage();
+    return 2;
+  }
+
+  ResultsDb db;
+  if (!db.open(dbPath)) {
+    fprintf(stderr, "Can't open %s\n", dbPath);
+    return 1;
+  }
+  printf("Results DB %s: %u sensors on record\n", dbPath, (unsigned)db.sensorCount());
+
+  std::vector<FixtureStation*> stations;
+  for (size_t i = 0; i < ports.size(); i++) {
+    stations.push_back(new FixtureStation(ports[i], config, db));
+  }
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+
+  unsigned long startMs = monotonicMs();
+  unsigned long nextStatusMs = statusMs;
+  std::vector<struct pollfd> fds;
+  std::vector<FixtureStation*> polled;
+
+  while (!stopRequested) {
+    unsigned long now = monotonicMs() - startMs;
+
+    // Timed work, and the earliest deadline to sleep until
+    unsigned long wake = now + 1000;
+    for (size_t i = 0; i < stations.size(); i++) {
+      stations[i]->tick(now);
+      if (stations[i]->nextDeadline() < wake) wake = stations[i]->nextDeadline();
+    }
+    if (statusMs > 0 && nextStatusMs < wake) wake = nextStatusMs;
+
+    if (untilEmpty) {
+      bool empty = true;
+      for (size_t i = 0; i < stations.size(); i++) {
+        StationState s = stations[i]->state();
+        if (s != STATION_NO_SENSOR && s != STATION_OFFLINE) empty = false;
+      }
+      if (empty) break;
+    }
+
+    fds.clear();
+    polled.clear();
+    for (size_t i = 0; i < stations.size(); i++) {
+      if (stations[i]->fd() < 0) continue;
+      struct pollfd pfd;
+      pfd.fd = stations[i]->fd();
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      fds.push_back(pfd);
+      polled.push_back(stations[i]);
+    }
+
+    int timeoutMs = wake > now ? (int)(wake - now) : 0;
+    int ready = poll(fds.empty() ? NULL : &fds[0], fds.size(), timeoutMs);
+    if (ready < 0 && errno != EINTR) {
+      perror("poll");
+      break;
+    }
+
+    now = monotonicMs() - startMs;
+    for (size_t i = 0; ready > 0 && i < fds.size(); i++) {
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) polled[i]->onReadable(now);
+    }
+
+    if (statusMs > 0 && now >= nextStatusMs) {
+      printStatus(stations, now);
+      nextStatusMs = now + statusMs;
+    }
+  }
+
+  unsigned long wallMs = monotonicMs() - startMs;
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  double cpuSec = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                  (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+  unsigned long bytes = 0;
+  for (size_t i = 0; i < stations.size(); i++) bytes += stations[i]->bytesIn();
+
+  printf("\n=== Results by NIST ID ===\n");
+  db.printSummary(stdout);
+  printf("\n%u stations, %.1f s wall, %.3f s CPU (%.3f%%), %lu bytes received\n",
+         (unsigned)stations.size(), wallMs / 1000.0, cpuSec,
+         wallMs > 0 ? 100.0 * cpuSec / (wallMs / 1000.0) : 0.0, bytes);
+
+  for (size_t i = 0; i < stations.size(); i++) delete stations[i];
+  return 0;
+}
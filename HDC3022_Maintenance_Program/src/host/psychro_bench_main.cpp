@@ -0,0 +1,144 @@
+// ============================================================================
+// DERIVED METRICS BENCHMARK (host)
+// Accuracy and speed of the single-precision dew point / absolute humidity
+// code in lib/HdcCore/Psychro against the double-precision libm formulas.
+//
+//   pio run -e native_psychro
+//   .pio/build/native_psychro/program [-n samples]
+//
+// Accuracy is checked on a dense grid (T = -40..85 C, RH = 1..100 %); the
+// worst errors found here are the bounds documented in Psychro.h.
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <chrono>
+#include <vector>
+
+#include "Psychro.h"
+
+#define GRID_T_MIN -40.0
+#define GRID_T_MAX 85.0
+#define GRID_RH_MIN 1.0
+#define GRID_RH_MAX 100.0
+#define GRID_STEP 0.05
+
+static volatile double benchSink;
+
+static double nowNs() {
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void checkAccuracy() {
+  double maxDew = 0.0, maxAhRel = 0.0, maxMargin = 0.0;
+  double worstDewT = 0.0, worstDewRH = 0.0;
+  unsigned long points = 0;
+
+  for (double t = GRID_T_MIN; t <= GRID_T_MAX; t += GRID_STEP) {
+    for (double rh = GRID_RH_MIN; rh <= GRID_RH_MAX; rh += GRID_STEP) {
+      // Compare on the float inputs the fast path actually sees
+      float tf = (float)t, rhf = (float)rh;
+      DerivedMetrics m;
+      computeDerivedMetrics(tf, rhf, m);
+
+      double dew = dewPointReference(tf, rhf);
+      double ah = absoluteHumidityReference(tf, rhf);
+      double margin = tf - dew;
+      if (margin < 0.0) margin = 0.0;
+
+      double dewErr = fabs(m.dewPoint - dew);
+      if (dewErr > maxDew) {
+        maxDew = dewErr;
+        worstDewT = t;
+        worstDewRH = rh;
+      }
+      double ahErr = fabs(m.absoluteHumidity - ah) / ah;
+      if (ahErr > maxAhRel) maxAhRel = ahErr;
+      double marginErr = fabs(m.margin - margin);
+      if (marginErr > maxMargin) maxMargin = marginErr;
+      points++;
+    }
+  }
+
+  printf("Accuracy over %lu points (T %.0f..%.0f C, RH %.0f..%.0f %%):\n",
+         points, GRID_T_MIN, GRID_T_MAX, GRID_RH_MIN, GRID_RH_MAX);
+  printf("  dew point          max |error| %.6f C  (at %.2f C, %.2f %%)\n", maxDew, worstDewT, worstDewRH);
+  printf("  absolute humidity  max relative error %.2e\n", maxAhRel);
+  printf("  margin             max |error| %.6f C\n", maxMargin);
+
+  // Single-function checks across a wide range
+  double maxLog = 0.0, maxExp = 0.0;
+  for (double x = 1e-6; x < 1e6; x *= 1.0007) {
+    double err = fabs(fastLogf((float)x) - log((float)x));
+    if (err > maxLog) maxLog = err;
+  }
+  for (double x = -80.0; x < 80.0; x += 0.001) {
+    double ref = exp((float)x);
+    double err = fabs(fastExpf((float)x) - ref) / ref;
+    if (err > maxExp) maxExp = err;
+  }
+  printf("  fastLogf           max |error| %.2e  (1e-6..1e6)\n", maxLog);
+  printf("  fastExpf           max relative error %.2e  (-80..80)\n", maxExp);
+}
+
+static void benchmark(size_t n) {
+  // Samples spread over the working range, as floats (what the firmware holds)
+  std::vector<float> temps(n), hums(n);
+  std::vector<DerivedMetrics> out(n);
+  uint32_t rng = 12345;
+  for (size_t i = 0; i < n; i++) {
+    rng = rng * 1664525u + 1013904223u;
+    temps[i] = -20.0f + 80.0f * (float)(rng >> 8) / 16777216.0f;
+    rng = rng * 1664525u + 1013904223u;
+    hums[i] = 1.0f + 99.0f * (float)(rng >> 8) / 16777216.0f;
+  }
+
+  const int ROUNDS = 20;
+
+  double start = nowNs();
+  for (int r = 0; r < ROUNDS; r++) {
+    computeDerivedMetricsBatch(&temps[0], &hums[0], &out[0], n);
+    benchSink = out[n - 1].dewPoint;
+  }
+  double fastNs = (nowNs() - start) / ((double)ROUNDS * n);
+
+  start = nowNs();
+  for (int r = 0; r < ROUNDS; r++) {
+    double acc = 0.0;
+    for (size_t i = 0; i < n; i++) {
+      double dew = dewPointReference(temps[i], hums[i]);
+      double ah = absoluteHumidityReference(temps[i], hums[i]);
+      acc += dew + ah + (temps[i] - dew);
+    }
+    benchSink = acc;
+  }
+  double refNs = (nowNs() - start) / ((double)ROUNDS * n);
+
+  printf("\nSpeed (%lu samples x %d rounds, dew point + AH + margin per sample):\n",
+         (unsigned long)n, ROUNDS);
+  printf("  fast (float)       %7.2f ns/sample\n", fastNs);
+  printf("  reference (libm)   %7.2f ns/sample\n", refNs);
+  printf("  speedup            %7.2fx\n", refNs / fastNs);
+}
+
+int main(int argc, char** argv) {
+  size_t n = 100000;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      n = strtoul(argv[++i], NULL, 10);
+    } else {
+      fprintf(stderr, "usage: psychro_bench [-n samples]\n");
+      return 2;
+    }
+  }
+  if (n == 0) n = 1;
+
+  checkAccuracy();
+  benchmark(n);
+  return 0;
+}
@@ -0,0 +1,539 @@
+// ============================================================================
+// HDC RECIPE TOOL (host)
+// Compiles maintenance recipes (lib/HdcCore/Recipe.h) from text, runs them
+// against the simulated sensor to check and time them before they go near a
+// station, and loads them onto one over USB.
+//
+//   pio run -e native_recipe
+//   .pio/build/native_recipe/program compile vented.txt -o vented.hrc
+//   .pio/build/native_recipe/program sim vented.hrc
+//   .pio/build/native_recipe/program send vented.hrc /dev/ttyACM0
+//   .pio/build/native_recipe/program show vented.hrc
+//   .pio/build/native_recipe/program builtin cond > cond.txt
+//   .pio/build/native_recipe/program builtin combined > combined.txt
+//
+// Text format, one directive per line, # starts a comment:
+//   name <up to 12 chars>           screen title
+//   operation cond|offset|combined  built-in procedure it replaces
+//   baseline LP0..LP3               initial reading mode (default LP0)
+//   final LP0..LP3                  post-cooldown reading mode (default LP0)
+//   heat off|quarter|half|full
+//   monitor rh-below|rise|lut-rise <value> [mode LPn] [poll ms] [timeout s] [fail]
+//   write-offset [mode LPn] [target %RH]
+//   cooldown <s>
+// ============================================================================
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "Maintenance.h"
+#include "Recipe.h"
+#include "SerialPort.h"
+#include "SimulatedHdc.h"
+
+#define REPLY_TIMEOUT_MS 5000
+
+static const char* const MODE_NAMES[HDC_MODE_COUNT] = { "LP0", "LP1", "LP2", "LP3" };
+static const char* const HEATER_NAMES[RECIPE_HEATER_COUNT] = { "off", "quarter", "half", "full" };
+static const char* const CONDITION_NAMES[RECIPE_CONDITION_COUNT] = { "rh-below", "rise", "lut-rise" };
+
+static const char* const OPERATION_NAMES[] = { "cond", "offset", "triage", "combined" };
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+// ============================================================================
+// TEXT -> RECIPE
+// ============================================================================
+
+static int lookup(const char* word, const char* const* names, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    if (strcmp(word, names[i]) == 0) return (int)i;
+  }
+  return -1;
+}
+
+static bool parseNumber(const char* word, double& value) {
+  char* end;
+  value = strtod(word, &end);
+  return end != word && *end == '\0';
+}
+
+// A threshold or target in hundredths, as the int16 step value holds it.
+// RH must also be a real RH.
+static bool parseHundredths(const char* word, bool rh, int16_t& hundredths, std::string& error) {
+  double value;
+  if (!parseNumber(word, value)) {
+    error = std::string("bad number ") + word;
+    return false;
+  }
+  double scaled = value * 100.0;
+  if (!(scaled > INT16_MIN - 0.5 && scaled < INT16_MAX + 0.5) || (rh && (value < 0 || value > 100))) {
+    error = std::string("out of range ") + word;
+    return false;
+  }
+  hundredths = (int16_t)lround(scaled);
+  return true;
+}
+
+// Options after a step's fixed arguments: mode / poll / timeout / target / fail
+static bool parseOptions(char** words, int count, RecipeStep& step, std::string& error) {
+  for (int i = 0; i < count; i++) {
+    double value;
+    if (strcmp(words[i], "fail") == 0 && step.op == RECIPE_MONITOR) {
+      step.flags |= RECIPE_FLAG_FAIL_ON_TIMEOUT;
+      continue;
+    }
+    if (i + 1 >= count) {
+      error = std::string("missing value after ") + words[i];
+      return false;
+    }
+    const char* key = words[i];
+    const char* arg = words[++i];
+
+    if (strcmp(key, "mode") == 0) {
+      int mode = lookup(arg, MODE_NAMES, HDC_MODE_COUNT);
+      if (mode < 0) {
+        error = std::string("unknown mode ") + arg;
+        return false;
+      }
+      step.mode = (uint8_t)mode;
+    } else if (!parseNumber(arg, value)) {
+      error = std::string("bad number ") + arg;
+      return false;
+    } else if (strcmp(key, "poll") == 0 && step.op == RECIPE_MONITOR && value >= 1 && value <= 65535) {
+      step.pollMs = (uint16_t)value;
+    } else if (strcmp(key, "timeout") == 0 && step.op == RECIPE_MONITOR && value >= 1 && value <= 65535) {
+      step.limitSec = (uint16_t)value;
+    } else if (strcmp(key, "target") == 0 && step.op == RECIPE_WRITE_OFFSET) {
+      if (!parseHundredths(arg, true, step.value, error)) return false;
+    } else {
+      error = std::string("unexpected ") + key;
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool parseLine(char* line, Recipe& recipe, std::string& error) {
+  char* hash = strchr(line, '#');
+  if (hash != NULL) *hash = '\0';
+
+  char* words[16];
+  int count = 0;
+  for (char* w = strtok(line, " \t\r\n"); w != NULL && count < 16; w = strtok(NULL, " \t\r\n")) {
+    words[count++] = w;
+  }
+  if (count == 0) return true;
+
+  const char* key = words[0];
+  if (strcmp(key, "name") == 0 && count >= 2) {
+    // The rest of the line, spaces included
+    std::string name = words[1];
+    for (int i = 2; i < count; i++) name += std::string(" ") + words[i];
+    if (name.size() > RECIPE_NAME_LEN) {
+      error = "name longer than 12 characters";
+      return false;
+    }
+    strncpy(recipe.name, name.c_str(), RECIPE_NAME_LEN);
+    return true;
+  }
+  if (strcmp(key, "operation") == 0 && count == 2) {
+    int op = lookup(words[1], OPERATION_NAMES, COUNT(OPERATION_NAMES));
+    if (op < 0 || op == MAINT_OP_TRIAGE) {
+      error = std::string("unknown operation ") + words[1];
+      return false;
+    }
+    recipe.operation = (MaintenanceOperation)op;
+    return true;
+  }
+  if ((strcmp(key, "baseline") == 0 || strcmp(key, "final") == 0) && count == 2) {
+    int mode = lookup(words[1], MODE_NAMES, HDC_MODE_COUNT);
+    if (mode < 0) {
+      error = std::string("unknown mode ") + words[1];
+      return false;
+    }
+    if (key[0] == 'b') {
+      recipe.baselineMode = (HdcMeasureMode)mode;
+    } else {
+      recipe.finalMode = (HdcMeasureMode)mode;
+    }
+    return true;
+  }
+
+  // Steps
+  if (recipe.stepCount >= RECIPE_MAX_STEPS) {
+    error = "too many steps";
+    return false;
+  }
+  RecipeStep step;
+  memset(&step, 0, sizeof(step));
+  double value;
+
+  if (strcmp(key, "heat") == 0 && count == 2) {
+    int power = lookup(words[1], HEATER_NAMES, RECIPE_HEATER_COUNT);
+    if (power < 0) {
+      error = std::string("unknown heater power ") + words[1];
+      return false;
+    }
+    step.op = RECIPE_HEAT;
+    step.arg = (uint8_t)power;
+  } else if (strcmp(key, "monitor") == 0 && count >= 3) {
+    int condition = lookup(words[1], CONDITION_NAMES, RECIPE_CONDITION_COUNT);
+    if (condition < 0) {
+      error = std::string("unknown condition ") + words[1];
+      return false;
+    }
+    if (!parseHundredths(words[2], condition == RECIPE_UNTIL_RH_BELOW, step.value, error)) return false;
+    step.op = RECIPE_MONITOR;
+    step.arg = (uint8_t)condition;
+    step.mode = HDC_MODE_LP3;
+    step.pollMs = 2000;
+    step.limitSec = 120;
+    if (!parseOptions(words + 3, count - 3, step, error)) return false;
+  } else if (strcmp(key, "write-offset") == 0) {
+    step.op = RECIPE_WRITE_OFFSET;
+    if (!parseOptions(words + 1, count - 1, step, error)) return false;
+  } else if (strcmp(key, "cooldown") == 0 && count == 2) {
+    if (!parseNumber(words[1], value) || value < 0 || value > 65535) {
+      error = std::string("bad cooldown ") + words[1];
+      return false;
+    }
+    step.op = RECIPE_COOLDOWN;
+    step.limitSec = (uint16_t)value;
+  } else {
+    error = std::string("unknown directive ") + key;
+    return false;
+  }
+
+  recipe.steps[recipe.stepCount++] = step;
+  return true;
+}
+
+static bool parseText(FILE* in, Recipe& recipe) {
+  memset(&recipe, 0, sizeof(recipe));
+  strncpy(recipe.name, "RECIPE", RECIPE_NAME_LEN);
+  recipe.operation = (MaintenanceOperation)MAINT_OP_COUNT;  // Must be given
+  recipe.baselineMode = HDC_MODE_LP0;
+  recipe.finalMode = HDC_MODE_LP0;
+
+  char line[256];
+  int lineNo = 0;
+  while (fgets(line, sizeof(line), in) != NULL) {
+    lineNo++;
+    std::string error;
+    if (!parseLine(line, recipe, error)) {
+      fprintf(stderr, "line %d: %s\n", lineNo, error.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+// ============================================================================
+// RECIPE -> TEXT
+// ============================================================================
+
+static void printText(FILE* out, const Recipe& r) {
+  fprintf(out, "name %s\n", r.name);
+  fprintf(out, "operation %s\n", OPERATION_NAMES[r.operation]);
+  fprintf(out, "baseline %s\n", MODE_NAMES[r.baselineMode]);
+  fprintf(out, "final %s\n", MODE_NAMES[r.finalMode]);
+
+  for (int i = 0; i < r.stepCount; i++) {
+    const RecipeStep& s = r.steps[i];
+    switch (s.op) {
+      case RECIPE_HEAT:
+        fprintf(out, "heat %s\n", HEATER_NAMES[s.arg]);
+        break;
+      case RECIPE_MONITOR:
+        fprintf(out, "monitor %s %.2f mode %s poll %u timeout %u%s\n", CONDITION_NAMES[s.arg],
+                s.value / 100.0, MODE_NAMES[s.mode], (unsigned)s.pollMs, (unsigned)s.limitSec,
+                (s.flags & RECIPE_FLAG_FAIL_ON_TIMEOUT) ? " fail" : "");
+        break;
+      case RECIPE_WRITE_OFFSET:
+        fprintf(out, "write-offset mode %s target %.2f\n", MODE_NAMES[s.mode], s.value / 100.0);
+        break;
+      case RECIPE_COOLDOWN:
+        fprintf(out, "cooldown %u\n", (unsigned)s.limitSec);
+        break;
+    }
+  }
+}
+
+// ============================================================================
+// FILES
+// ============================================================================
+
+// Binary (starts with the magic) or text
+static bool loadRecipe(const char* path, Recipe& recipe) {
+  FILE* in = fopen(path, "rb");
+  if (in == NULL) {
+    fprintf(stderr, "Cannot open %s\n", path);
+    return false;
+  }
+
+  uint8_t data[RECIPE_MAX_SIZE + 1];
+  size_t len = fread(data, 1, sizeof(data), in);
+  bool binary = len >= 2 && data[0] == RECIPE_MAGIC0 && data[1] == RECIPE_MAGIC1;
+  bool ok;
+
+  if (binary) {
+    RecipeStatus status = recipeDecode(data, len, recipe);
+    if (status != RECIPE_OK) fprintf(stderr, "%s: %s\n", path, recipeStatusName(status));
+    ok = status == RECIPE_OK;
+  } else {
+    rewind(in);
+    ok = parseText(in, recipe);
+    if (ok) {
+      int badStep;
+      RecipeStatus status = recipeValidate(recipe, &badStep);
+      if (status != RECIPE_OK) {
+        fprintf(stderr, "%s: %s", path, recipeStatusName(status));
+        if (badStep >= 0) fprintf(stderr, " (step %d)", badStep + 1);
+        fprintf(stderr, "\n");
+        ok = false;
+      }
+    }
+  }
+  fclose(in);
+  return ok;
+}
+
+static void printHexCommand(FILE* out, const uint8_t* data, size_t len) {
+  char hex[2 * RECIPE_MAX_SIZE + 1];
+  recipeToHex(data, len, hex);
+  fprintf(out, "RECIPE LOAD %s\n", hex);
+}
+
+// ============================================================================
+// SIMULATION
+// ============================================================================
+
+static const double AMBIENT_TEMP_GRID[] = { 15.0, 20.0, 25.0, 30.0, 35.0 };
+static const double AMBIENT_RH_GRID[] = { 10.0, 30.0, 50.0, 70.0, 90.0 };
+static const double DRIFT_GRID[] = { -3.0, -1.0, 1.0, 3.0 };
+static const double CONDENSATE_GRID[] = { 0.5, 2.0, 5.0 };
+
+struct SimStats {
+  int runs;
+  int successes;
+  double totalSec;
+  double maxSec;
+  double totalError;
+  double maxError;
+  SimConditions slowest;
+};
+
+// Same final error as the parameter sweep (sweep_main.cpp)
+static double finalError(MaintenanceOperation op, SimulatedHdc& sim, const MaintenanceResult& result) {
+  const SimConditions& c = sim.conditions();
+  if (op == MAINT_OP_CONDENSATION) {
+    return fabs(result.finalHumidity - (c.ambientHumidity + c.humidityDrift));
+  }
+  double writtenTemp, writtenHumidity;
+  sim.readOffsets(writtenTemp, writtenHumidity);
+  return fabs(writtenHumidity + c.humidityDrift);
+}
+
+static void simulate(const Recipe* recipe, MaintenanceOperation op, SimStats& stats) {
+  MaintenanceObserver quiet;
+  uint32_t seed = 1;
+  memset(&stats, 0, sizeof(stats));
+
+  bool wet = op == MAINT_OP_CONDENSATION || op == MAINT_OP_COMBINED;
+  size_t wetCount = wet ? COUNT(CONDENSATE_GRID) : 1;
+  for (size_t t = 0; t < COUNT(AMBIENT_TEMP_GRID); t++)
+    for (size_t h = 0; h < COUNT(AMBIENT_RH_GRID); h++)
+      for (size_t d = 0; d < COUNT(DRIFT_GRID); d++)
+        for (size_t w = 0; w < wetCount; w++) {
+          SimConditions c;
+          c.ambientTemp = AMBIENT_TEMP_GRID[t];
+          c.ambientHumidity = AMBIENT_RH_GRID[h];
+          c.humidityDrift = DRIFT_GRID[d];
+          c.condensate = wet ? CONDENSATE_GRID[w] : 0.0;
+          c.tempNoise = 0.05;
+          c.humidityNoise = 0.1;
+          c.seed = seed++ * 2654435761u;
+
+          SimulatedHdc sim(c);
+          MaintenanceResult result;
+          if (recipe != NULL) {
+            maintenanceRunRecipe(sim, *recipe, quiet, result);
+          } else if (op == MAINT_OP_CONDENSATION) {
+            maintenanceCondensationRemoval(sim, DEFAULT_CONDENSATION_PARAMS, quiet, result);
+          } else if (op == MAINT_OP_COMBINED) {
+            CombinedResult combined;
+            maintenanceCombined(sim, DEFAULT_CONDENSATION_PARAMS, DEFAULT_OFFSET_PARAMS, quiet,
+                                result, combined);
+          } else {
+            maintenanceOffsetCorrection(sim, DEFAULT_OFFSET_PARAMS, quiet, result);
+          }
+
+          double sec = result.durationMs / 1000.0;
+          double error = finalError(op, sim, result);
+          stats.runs++;
+          if (result.success) stats.successes++;
+          stats.totalSec += sec;
+          if (sec > stats.maxSec) {
+            stats.maxSec = sec;
+            stats.slowest = c;
+          }
+          stats.totalError += error;
+          if (error > stats.maxError) stats.maxError = error;
+        }
+}
+
+static void printStats(const char* label, const SimStats& s) {
+  printf("%-12s %5d %7.1f%% %8.1f %8.1f %9.3f %9.3f\n", label, s.runs, 100.0 * s.successes / s.runs,
+         s.totalSec / s.runs, s.maxSec, s.totalError / s.runs, s.maxError);
+}
+
+static int runSim(const Recipe& recipe) {
+  static const char* const LABELS[] = { "condensation removal", "offset correction", "triage",
+                                       "combined dry + offset" };
+  printf("%s: %s, %d steps\n", recipe.name, LABELS[recipe.operation], recipe.stepCount);
+
+  SimStats mine, builtin;
+  simulate(&recipe, recipe.operation, mine);
+  simulate(NULL, recipe.operation, builtin);
+
+  printf("%-12s %5s %8s %8s %8s %9s %9s\n", "", "runs", "success", "mean s", "max s", "mean err", "max err");
+  printStats("recipe", mine);
+  printStats("built-in", builtin);
+  printf("slowest: %.0f C, %.0f %%RH, drift %+.1f, condensate %.1f\n", mine.slowest.ambientTemp,
+         mine.slowest.ambientHumidity, mine.slowest.humidityDrift, mine.slowest.condensate);
+
+  // Non-zero exit for scripts when any simulated run failed
+  return mine.successes == mine.runs ? 0 : 1;
+}
+
+// ============================================================================
+// UPLOAD
+// ============================================================================
+
+// One line without the line ending; false on timeout
+static bool readLine(int fd, std::string& line) {
+  line.clear();
+  for (;;) {
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, REPLY_TIMEOUT_MS) <= 0) return false;
+
+    char c;
+    ssize_t n = read(fd, &c, 1);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) continue;
+      return false;
+    }
+    if (c == '\n') return true;
+    if (c != '\r') line += c;
+  }
+}
+
+static int sendRecipe(const uint8_t* data, size_t len, const char* port) {
+  int fd = serialPortOpen(port, O_RDWR);
+  if (fd < 0) {
+    fprintf(stderr, "Cannot open %s\n", port);
+    return 2;
+  }
+
+  char hex[2 * RECIPE_MAX_SIZE + 1];
+  recipeToHex(data, len, hex);
+  std::string cmd = std::string("RECIPE LOAD ") + hex + "\n";
+  if (write(fd, cmd.c_str(), cmd.size()) != (ssize_t)cmd.size()) {
+    fprintf(stderr, "Failed to send the recipe\n");
+    close(fd);
+    return 1;
+  }
+
+  // Skip the normal log until the reply
+  std::string line;
+  while (readLine(fd, line)) {
+    if (line.compare(0, 7, "RECIPE ") == 0) {
+      printf("%s\n", line.c_str());
+      close(fd);
+      return line == "RECIPE stored" ? 0 : 1;
+    }
+  }
+  fprintf(stderr, "No reply from %s\n", port);
+  close(fd);
+  return 1;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static int usage() {
+  fprintf(stderr,
+          "usage: recipe compile <recipe.txt> [-o out.hrc]\n"
+          "       recipe show <recipe>\n"
+          "       recipe sim <recipe>\n"
+          "       recipe send <recipe> <port>\n"
+          "       recipe builtin cond|offset|combined\n");
+  return 2;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) return usage();
+  const char* cmd = argv[1];
+  Recipe recipe;
+
+  if (strcmp(cmd, "builtin") == 0) {
+    if (strcmp(argv[2], "cond") == 0) {
+      recipeFromCondensationParams(DEFAULT_CONDENSATION_PARAMS, recipe);
+    } else if (strcmp(argv[2], "offset") == 0) {
+      recipeFromOffsetParams(DEFAULT_OFFSET_PARAMS, recipe);
+    } else if (strcmp(argv[2], "combined") == 0) {
+      recipeFromCombinedParams(DEFAULT_CONDENSATION_PARAMS, DEFAULT_OFFSET_PARAMS, recipe);
+    } else {
+      return usage();
+    }
+    printText(stdout, recipe);
+    return 0;
+  }
+
+  if (!loadRecipe(argv[2], recipe)) return 1;
+  uint8_t data[RECIPE_MAX_SIZE];
+  size_t len = recipeEncode(recipe, data);
+
+  if (strcmp(cmd, "compile") == 0) {
+    const char* outPath = argc == 5 && strcmp(argv[3], "-o") == 0 ? argv[4] : NULL;
+    if (outPath == NULL) {
+      printHexCommand(stdout, data, len);
+      return 0;
+    }
+    FILE* out = fopen(outPath, "wb");
+    if (out == NULL || fwrite(data, 1, len, out) != len) {
+      fprintf(stderr, "Cannot write %s\n", outPath);
+      return 2;
+    }
+    fclose(out);
+    printf("%s: %d steps, %lu bytes\n", outPath, recipe.stepCount, (unsigned long)len);
+    return 0;
+  }
+  if (strcmp(cmd, "show") == 0) {
+    printText(stdout, recipe);
+    printf("# %lu bytes\n# ", (unsigned long)len);
+    printHexCommand(stdout, data, len);
+    return 0;
+  }
+  if (strcmp(cmd, "sim") == 0) {
+    return runSim(recipe);
+  }
+  if (strcmp(cmd, "send") == 0 && argc == 4) {
+    return sendRecipe(data, len, argv[3]);
+  }
+  return usage();
+}
@@ -0,0 +1,167 @@
+// ============================================================================
+// HDC MAINTENANCE REPLAY HARNESS (host)
+// Pushes captured field runs through the current maintenance algorithms and
+// flags regressions in duration, outcome and written offsets.
+//
+//   pio run -e native_replay
+//   .pio/build/native_replay/program [options] capture.log [...]
+//
+// Options override the algorithm defaults so threshold / timing changes can
+// be tried against the corpus before they are flashed:
+//   --cr-exit-rh <pct>    --cr-poll <ms>   --cr-timeout <ms>
+//   --oc-poll <ms>        --oc-timeout <ms>
+//   --cooldown <ms>       (both operations)
+//   --duration-tol <s>    allowed slowdown vs. capture   (default 2)
+//   --offset-tol <pct>    allowed RH offset difference   (default 0.25)
+//   -v                    print every replayed sample
+// Exit status is 1 if any run regressed.
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Maintenance.h"
+#include "ReplayBackend.h"
+
+class ReplayObserver : public MaintenanceObserver {
+public:
+  explicit ReplayObserver(bool verbose) : verbose(verbose) {}
+
+  void onReport(const MaintenanceReport& r) {
+    if (!verbose || r.event != MAINT_EVT_SAMPLE) return;
+    printf("    %6.1fs  T=%6.2f  RH=%6.2f  rise=%6.2f\n",
+           r.elapsedMs / 1000.0, r.temperature, r.humidity, r.rise);
+  }
+
+private:
+  bool verbose;
+};
+
+static const char* operationName(MaintenanceOperation op) {
+  switch (op) {
+    case MAINT_OP_CONDENSATION: return "condensation";
+    case MAINT_OP_TRIAGE:       return "triage";
+    case MAINT_OP_COMBINED:     return "combined";
+    default:                    return "offset-corr";
+  }
+}
+
+static void usage() {
+  fprintf(stderr, "usage: replay [options] capture.log [...]\n");
+}
+
+int main(int argc, char** argv) {
+  CondensationParams crParams = DEFAULT_CONDENSATION_PARAMS;
+  OffsetCorrectionParams ocParams = DEFAULT_OFFSET_PARAMS;
+  double durationTolSec = 2.0;
+  double offsetTol = 0.25;
+  bool verbose = false;
+
+  std::vector<CaptureRun> runs;
+  int files = 0;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (strcmp(arg, "-v") == 0) {
+      verbose = true;
+    } else if (strcmp(arg, "--cr-exit-rh") == 0 && hasValue) {
+      crParams.exitHumidity = atof(argv[++i]);
+    } else if (strcmp(arg, "--cr-poll") == 0 && hasValue) {
+      crParams.pollIntervalMs = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(arg, "--cr-timeout") == 0 && hasValue) {
+      crParams.timeoutMs = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(arg, "--oc-poll") == 0 && hasValue) {
+      ocParams.pollIntervalMs = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(arg, "--oc-timeout") == 0 && hasValue) {
+      ocParams.timeoutMs = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(arg, "--cooldown") == 0 && hasValue) {
+      crParams.cooldownMs = ocParams.cooldownMs = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(arg, "--duration-tol") == 0 && hasValue) {
+      durationTolSec = atof(argv[++i]);
+    } else if (strcmp(arg, "--offset-tol") == 0 && hasValue) {
+      offsetTol = atof(argv[++i]);
+    } else if (arg[0] == '-') {
+      usage();
+      return 2;
+    } else {
+      if (!loadCaptureRuns(arg, runs)) {
+        fprintf(stderr, "Cannot read %s\n", arg);
+        return 2;
+      }
+      files++;
+    }
+  }
+
+  if (files == 0) {
+    usage();
+    return 2;
+  }
+
+  printf("%-4s %-12s %10s %10s %9s %9s  %s\n",
+         "run", "operation", "rec dur s", "new dur s", "rec RHoff", "new RHoff", "verdict");
+
+  int regressions = 0;
+  int inconclusive = 0;
+
+  for (size_t i = 0; i < runs.size(); i++) {
+    const CaptureRun& run = runs[i];
+    if (!run.complete) {
+      printf("%-4u %-12s (incomplete capture, skipped)\n", (unsigned)i, operationName(run.operation));
+      continue;
+    }
+    if (run.recipe) {
+      // Only the built-in procedures are replayed
+      printf("%-4u %-12s (stored recipe, skipped)\n", (unsigned)i, operationName(run.operation));
+      continue;
+    }
+
+    ReplayBackend backend(run);
+    ReplayObserver observer(verbose);
+    MaintenanceResult result;
+
+    if (run.operation == MAINT_OP_CONDENSATION) {
+      maintenanceCondensationRemoval(backend, crParams, observer, result);
+    } else if (run.operation == MAINT_OP_TRIAGE) {
+      TriageResult triage;
+      maintenanceTriage(backend, DEFAULT_TRIAGE_PARAMS, observer, result, triage);
+    } else if (run.operation == MAINT_OP_COMBINED) {
+      CombinedResult combined;
+      maintenanceCombined(backend, crParams, ocParams, observer, result, combined);
+    } else {
+      maintenanceOffsetCorrection(backend, ocParams, observer, result);
+    }
+
+    double newOffset = 0.0, newTempOffset = 0.0;
+    backend.readOffsets(newTempOffset, newOffset);
+
+    double recDur = run.recordedDurationMs / 1000.0;
+    double newDur = result.durationMs / 1000.0;
+
+    const char* verdict = "ok";
+    if (backend.outOfTraceReads() > 0 || backend.heaterDivergentReads() > 0) {
+      // The candidate asked for data the capture can't provide
+      verdict = "INCONCLUSIVE (left captured trace)";
+      inconclusive++;
+    } else if (run.recordedSuccess && !result.success) {
+      verdict = "REGRESSION (outcome)";
+      regressions++;
+    } else if (newDur > recDur + durationTolSec) {
+      verdict = "REGRESSION (duration)";
+      regressions++;
+    } else if (run.hasRecordedOffsets && fabs(newOffset - run.recordedHumidityOffset) > offsetTol) {
+      verdict = "REGRESSION (offset)";
+      regressions++;
+    }
+
+    printf("%-4u %-12s %10.1f %10.1f %9.2f %9.2f  %s\n",
+           (unsigned)i, operationName(run.operation), recDur, newDur,
+           run.recordedHumidityOffset, newOffset, verdict);
+  }
+
+  printf("\n%u runs, %d regressions, %d inconclusive\n", (unsigned)runs.size(), regressions, inconclusive);
+  return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,519 @@
+// ============================================================================
+// HDC MAINTENANCE PARAMETER SWEEP (host)
+// Runs the lib/HdcCore maintenance algorithms against the simulated sensor
+// for every combination of tuning parameters x ambient conditions, on all
+// cores, and prints the Pareto front of cycle time vs. final error.
+//
+//   pio run -e native_sweep
+//   .pio/build/native_sweep/program [-j threads] [--csv all.csv]
+//
+// Final error:
+//   condensation removal - |post-cooldown RH - settled RH reading|
+//                          (residual heat / moisture still biasing the part)
+//   offset correction    - |written RH offset + true drift|
+//                          (drift left uncorrected)
+//
+// Then checks the default triage settings and compares the combined dry +
+// offset cycle with the two operations run back to back on soaked parts.
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Maintenance.h"
+#include "SimulatedHdc.h"
+
+// ============================================================================
+// GRIDS
+// ============================================================================
+
+static const HdcHeaterPower HEATER_GRID[] = { HDC_HEATER_HALF_POWER, HDC_HEATER_FULL_POWER };
+
+static const unsigned long CR_POLL_GRID[] = { 1000, 2000, 5000 };
+static const unsigned long CR_TIMEOUT_GRID[] = { 120000, 300000 };
+static const double CR_EXIT_RH_GRID[] = { 0.5, 1.0, 2.0, 5.0 };
+static const unsigned long CR_COOLDOWN_GRID[] = { 5000, 10000, 20000 };
+
+static const unsigned long OC_POLL_GRID[] = { 1000, 2000 };
+static const unsigned long OC_TIMEOUT_GRID[] = { 60000, 120000 };
+static const unsigned long OC_COOLDOWN_GRID[] = { 5000, 10000, 20000 };
+static const float OC_LUT_SCALE_GRID[] = { 0.8f, 0.9f, 1.0f, 1.1f, 1.2f };
+
+// Conversion mode for heating-ramp reads (both operations) and for the
+// offset sample (offset correction)
+static const HdcMeasureMode RAMP_MODE_GRID[] = { HDC_MODE_LP0, HDC_MODE_LP3 };
+static const HdcMeasureMode PLATEAU_MODE_GRID[] = { HDC_MODE_LP0, HDC_MODE_LP3 };
+
+static const double AMBIENT_TEMP_GRID[] = { 15.0, 20.0, 25.0, 30.0, 35.0 };
+static const double AMBIENT_RH_GRID[] = { 10.0, 20.0, 30.0, 40.0, 50.0, 60.0, 70.0, 80.0, 90.0 };
+static const double DRIFT_GRID[] = { -3.0, -1.0, 1.0, 3.0 };
+static const double CONDENSATE_GRID[] = { 0.5, 2.0, 5.0 };
+
+// Quick triage check (default settings): drifts either side of the
+// offset threshold, dry and soaked parts
+static const double TRIAGE_DRIFT_GRID[] = { -3.0, -1.5, -0.5, 0.0, 0.5, 1.5, 3.0 };
+static const double TRIAGE_CONDENSATE_GRID[] = { 0.0, 0.5, 2.0, 5.0 };
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+// ============================================================================
+// CANDIDATES
+// ============================================================================
+
+struct Candidate {
+  MaintenanceOperation operation;
+  CondensationParams cr;
+  OffsetCorrectionParams oc;
+  float lutScale;
+  float lut[OFFSET_LUT_ROWS][OFFSET_LUT_COLS];
+
+  // Results (written by exactly one worker)
+  double meanCycleSec;
+  double maxCycleSec;
+  double meanError;
+  double successRate;
+  bool pareto;
+};
+
+static std::vector<SimConditions> buildConditions(MaintenanceOperation op) {
+  std::vector<SimConditions> conditions;
+  uint32_t seed = 1;
+
+  for (size_t t = 0; t < COUNT(AMBIENT_TEMP_GRID); t++) {
+    for (size_t h = 0; h < COUNT(AMBIENT_RH_GRID); h++) {
+      for (size_t d = 0; d < COUNT(DRIFT_GRID); d++) {
+        size_t wetCount = op == MAINT_OP_CONDENSATION ? COUNT(CONDENSATE_GRID) : 1;
+        for (size_t w = 0; w < wetCount; w++) {
+          SimConditions c;
+          c.ambientTemp = AMBIENT_TEMP_GRID[t];
+          c.ambientHumidity = AMBIENT_RH_GRID[h];
+          c.humidityDrift = DRIFT_GRID[d];
+          c.condensate = op == MAINT_OP_CONDENSATION ? CONDENSATE_GRID[w] : 0.0;
+          c.tempNoise = 0.05;
+          c.humidityNoise = 0.1;
+          c.seed = seed++ * 2654435761u;
+          conditions.push_back(c);
+        }
+      }
+    }
+  }
+  return conditions;
+}
+
+static void buildCandidates(std::vector<Candidate>& out) {
+  Candidate c;
+  memset(&c, 0, sizeof(c));
+
+  c.operation = MAINT_OP_CONDENSATION;
+  c.cr = DEFAULT_CONDENSATION_PARAMS;
+  for (size_t a = 0; a < COUNT(HEATER_GRID); a++)
+    for (size_t b = 0; b < COUNT(CR_POLL_GRID); b++)
+      for (size_t d = 0; d < COUNT(CR_TIMEOUT_GRID); d++)
+        for (size_t e = 0; e < COUNT(CR_EXIT_RH_GRID); e++)
+          for (size_t f = 0; f < COUNT(CR_COOLDOWN_GRID); f++)
+            for (size_t g = 0; g < COUNT(RAMP_MODE_GRID); g++) {
+              c.cr.heaterPower = HEATER_GRID[a];
+              c.cr.pollIntervalMs = CR_POLL_GRID[b];
+              c.cr.timeoutMs = CR_TIMEOUT_GRID[d];
+              c.cr.exitHumidity = CR_EXIT_RH_GRID[e];
+              c.cr.cooldownMs = CR_COOLDOWN_GRID[f];
+              c.cr.modes.ramp = RAMP_MODE_GRID[g];
+              out.push_back(c);
+            }
+
+  c.operation = MAINT_OP_OFFSET_CORRECTION;
+  c.oc = DEFAULT_OFFSET_PARAMS;
+  for (size_t a = 0; a < COUNT(HEATER_GRID); a++)
+    for (size_t b = 0; b < COUNT(OC_POLL_GRID); b++)
+      for (size_t d = 0; d < COUNT(OC_TIMEOUT_GRID); d++)
+        for (size_t e = 0; e < COUNT(OC_COOLDOWN_GRID); e++)
+          for (size_t f = 0; f < COUNT(OC_LUT_SCALE_GRID); f++)
+            for (size_t g = 0; g < COUNT(RAMP_MODE_GRID); g++)
+              for (size_t h = 0; h < COUNT(PLATEAU_MODE_GRID); h++) {
+                c.oc.heaterPower = HEATER_GRID[a];
+                c.oc.pollIntervalMs = OC_POLL_GRID[b];
+                c.oc.timeoutMs = OC_TIMEOUT_GRID[d];
+                c.oc.cooldownMs = OC_COOLDOWN_GRID[e];
+                c.lutScale = OC_LUT_SCALE_GRID[f];
+                c.oc.modes.ramp = RAMP_MODE_GRID[g];
+                c.oc.modes.plateau = PLATEAU_MODE_GRID[h];
+                out.push_back(c);
+              }
+
+  // Scaled LUT copies - riseLut is pointed at them once the vector is stable
+  for (size_t i = 0; i < out.size(); i++) {
+    Candidate& cand = out[i];
+    if (cand.operation != MAINT_OP_OFFSET_CORRECTION) continue;
+    for (int r = 0; r < OFFSET_LUT_ROWS; r++)
+      for (int col = 0; col < OFFSET_LUT_COLS; col++)
+        cand.lut[r][col] = OFFSET_RISE_LUT[r][col] * cand.lutScale;
+    cand.oc.riseLut = cand.lut;
+  }
+}
+
+// ============================================================================
+// EVALUATION
+// ============================================================================
+
+static void evaluate(Candidate& cand, const std::vector<SimConditions>& conditions) {
+  MaintenanceObserver quiet;
+  double totalSec = 0.0, maxSec = 0.0, totalError = 0.0;
+  int successes = 0;
+
+  for (size_t i = 0; i < conditions.size(); i++) {
+    SimulatedHdc sim(conditions[i]);
+    MaintenanceResult result;
+    double error;
+
+    if (cand.operation == MAINT_OP_CONDENSATION) {
+      maintenanceCondensationRemoval(sim, cand.cr, quiet, result);
+      double settled = conditions[i].ambientHumidity + conditions[i].humidityDrift;
+      error = fabs(result.finalHumidity - settled);
+    } else {
+      maintenanceOffsetCorrection(sim, cand.oc, quiet, result);
+      double writtenTemp, writtenHumidity;
+      sim.readOffsets(writtenTemp, writtenHumidity);
+      error = fabs(writtenHumidity + conditions[i].humidityDrift);
+    }
+
+    double sec = result.durationMs / 1000.0;
+    totalSec += sec;
+    if (sec > maxSec) maxSec = sec;
+    totalError += error;
+    if (result.success) successes++;
+  }
+
+  cand.meanCycleSec = totalSec / conditions.size();
+  cand.maxCycleSec = maxSec;
+  cand.meanError = totalError / conditions.size();
+  cand.successRate = 100.0 * successes / conditions.size();
+}
+
+// Non-dominated in (mean cycle time, mean error); only fully successful
+// candidates are eligible when any exist
+static void markPareto(std::vector<Candidate>& cands, MaintenanceOperation op) {
+  bool anyFullSuccess = false;
+  for (size_t i = 0; i < cands.size(); i++) {
+    if (cands[i].operation == op && cands[i].successRate >= 100.0) anyFullSuccess = true;
+  }
+
+  for (size_t i = 0; i < cands.size(); i++) {
+    Candidate& a = cands[i];
+    if (a.operation != op) continue;
+    a.pareto = false;
+    if (anyFullSuccess && a.successRate < 100.0) continue;
+
+    bool dominated = false;
+    for (size_t j = 0; j < cands.size() && !dominated; j++) {
+      const Candidate& b = cands[j];
+      if (j == i || b.operation != op) continue;
+      if (anyFullSuccess && b.successRate < 100.0) continue;
+      // Exact ties (e.g. a timeout that never triggers) keep only the first
+      if (b.meanCycleSec <= a.meanCycleSec && b.meanError <= a.meanError &&
+          (b.meanCycleSec < a.meanCycleSec || b.meanError < a.meanError || j < i)) {
+        dominated = true;
+      }
+    }
+    a.pareto = !dominated;
+  }
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+static const char* heaterName(HdcHeaterPower power) {
+  switch (power) {
+    case HDC_HEATER_FULL_POWER: return "FULL";
+    case HDC_HEATER_HALF_POWER: return "HALF";
+    case HDC_HEATER_QUARTER_POWER: return "QUARTER";
+    default: return "OFF";
+  }
+}
+
+static const char* modeName(HdcMeasureMode mode) {
+  static const char* const NAMES[HDC_MODE_COUNT] = { "LP0", "LP1", "LP2", "LP3" };
+  return NAMES[mode];
+}
+
+static bool byCycleTime(const Candidate* a, const Candidate* b) {
+  return a->meanCycleSec < b->meanCycleSec;
+}
+
+static bool isDefault(const Candidate& c) {
+  if (c.operation == MAINT_OP_CONDENSATION) {
+    const CondensationParams& d = DEFAULT_CONDENSATION_PARAMS;
+    return c.cr.heaterPower == d.heaterPower && c.cr.pollIntervalMs == d.pollIntervalMs &&
+           c.cr.timeoutMs == d.timeoutMs && c.cr.exitHumidity == d.exitHumidity &&
+           c.cr.cooldownMs == d.cooldownMs && c.cr.modes.ramp == d.modes.ramp;
+  }
+  const OffsetCorrectionParams& d = DEFAULT_OFFSET_PARAMS;
+  return c.oc.heaterPower == d.heaterPower && c.oc.pollIntervalMs == d.pollIntervalMs &&
+         c.oc.timeoutMs == d.timeoutMs && c.oc.cooldownMs == d.cooldownMs && c.lutScale == 1.0f &&
+         c.oc.modes.ramp == d.modes.ramp && c.oc.modes.plateau == d.modes.plateau;
+}
+
+static void printCandidate(FILE* out, const Candidate& c, bool csv) {
+  if (c.operation == MAINT_OP_CONDENSATION) {
+    fprintf(out, csv ? "condensation,%s,%lu,%lu,%.1f,%lu,,%s,," : "%-4s poll=%-5lu timeout=%-6lu exitRH=%-4.1f cool=%-5lu          ramp=%s           ",
+            heaterName(c.cr.heaterPower), c.cr.pollIntervalMs, c.cr.timeoutMs,
+            c.cr.exitHumidity, c.cr.cooldownMs, modeName(c.cr.modes.ramp));
+  } else {
+    fprintf(out, csv ? "offset,%s,%lu,%lu,,%lu,%.2f,%s,%s," : "%-4s poll=%-5lu timeout=%-6lu            cool=%-5lu lut=%.2f ramp=%s plateau=%s",
+            heaterName(c.oc.heaterPower), c.oc.pollIntervalMs, c.oc.timeoutMs,
+            c.oc.cooldownMs, c.lutScale, modeName(c.oc.modes.ramp), modeName(c.oc.modes.plateau));
+  }
+  if (csv) {
+    fprintf(out, "%.2f,%.2f,%.3f,%.1f,%d\n",
+            c.meanCycleSec, c.maxCycleSec, c.meanError, c.successRate, (int)c.pareto);
+  } else {
+    fprintf(out, "  %8.1f %8.1f %8.3f %6.1f%s\n",
+            c.meanCycleSec, c.maxCycleSec, c.meanError, c.successRate,
+            isDefault(c) ? "  <- current" : "");
+  }
+}
+
+static void printFront(const std::vector<Candidate>& cands, MaintenanceOperation op, const char* title) {
+  std::vector<const Candidate*> front;
+  const Candidate* current = NULL;
+  for (size_t i = 0; i < cands.size(); i++) {
+    if (cands[i].operation != op) continue;
+    if (cands[i].pareto) front.push_back(&cands[i]);
+    if (isDefault(cands[i])) current = &cands[i];
+  }
+  std::sort(front.begin(), front.end(), byCycleTime);
+
+  printf("\n=== %s: Pareto front (%u points) ===\n", title, (unsigned)front.size());
+  printf("%-83s %8s %8s %8s %6s\n", "parameters", "mean s", "max s", "error", "ok %");
+  for (size_t i = 0; i < front.size(); i++) {
+    printCandidate(stdout, *front[i], false);
+  }
+  if (current != NULL && !current->pareto) {
+    printf("current settings (dominated):\n");
+    printCandidate(stdout, *current, false);
+  }
+}
+
+// ============================================================================
+// QUICK TRIAGE
+// Default triage settings against the simulator's ground truth, and time
+// per part compared with always running a full offset correction.
+// ============================================================================
+
+static TriageVerdict triageTruth(const SimConditions& c) {
+  if (c.condensate > 0.0) return TRIAGE_NEEDS_CONDENSATION_REMOVAL;
+  if (fabs(c.humidityDrift) > DEFAULT_TRIAGE_PARAMS.offsetThreshold) return TRIAGE_NEEDS_OFFSET_CORRECTION;
+  return TRIAGE_OK;
+}
+
+static void evaluateTriage() {
+  MaintenanceObserver quiet;
+  unsigned int confusion[3][3] = { { 0 } };  // [truth][verdict]
+  unsigned int failed = 0, total = 0;
+  double triageSec = 0.0, correctionSec = 0.0, maxTriageSec = 0.0;
+  unsigned int dry = 0;
+  uint32_t seed = 1;
+
+  for (size_t t = 0; t < COUNT(AMBIENT_TEMP_GRID); t++)
+    for (size_t h = 0; h < COUNT(AMBIENT_RH_GRID); h++)
+      for (size_t d = 0; d < COUNT(TRIAGE_DRIFT_GRID); d++)
+        for (size_t w = 0; w < COUNT(TRIAGE_CONDENSATE_GRID); w++) {
+          SimConditions c;
+          c.ambientTemp = AMBIENT_TEMP_GRID[t];
+          c.ambientHumidity = AMBIENT_RH_GRID[h];
+          c.humidityDrift = TRIAGE_DRIFT_GRID[d];
+          c.condensate = TRIAGE_CONDENSATE_GRID[w];
+          c.tempNoise = 0.05;
+          c.humidityNoise = 0.1;
+          c.seed = seed++ * 2654435761u;
+
+          SimulatedHdc sim(c);
+          MaintenanceResult result;
+          TriageResult triage;
+          total++;
+          if (!maintenanceTriage(sim, DEFAULT_TRIAGE_PARAMS, quiet, result, triage)) {
+            failed++;
+            continue;
+          }
+          confusion[triageTruth(c)][triage.verdict]++;
+          double sec = result.durationMs / 1000.0;
+          triageSec += sec;
+          if (sec > maxTriageSec) maxTriageSec = sec;
+
+          // What the part would have cost without triage
+          if (c.condensate == 0.0) {
+            SimulatedHdc full(c);
+            maintenanceOffsetCorrection(full, DEFAULT_OFFSET_PARAMS, quiet, result);
+            correctionSec += result.durationMs / 1000.0;
+            dry++;
+          }
+        }
+
+  static const char* const SHORT[3] = { "ok", "offset", "condens." };
+  printf("\n=== QUICK TRIAGE (default settings, %u parts) ===\n", total);
+  printf("%-16s %8s %8s %8s\n", "truth \\ verdict", SHORT[0], SHORT[1], SHORT[2]);
+  for (int truth = 0; truth < 3; truth++) {
+    printf("%-16s %8u %8u %8u\n", SHORT[truth], confusion[truth][0], confusion[truth][1],
+           confusion[truth][2]);
+  }
+  if (failed > 0) printf("unclassified: %u\n", failed);
+  if (failed == total) {
+    // No timings to average or compare
+    printf("triage failed on every part\n");
+    return;
+  }
+
+  double meanTriage = triageSec / (total - failed);
+  double meanCorrection = dry > 0 ? correctionSec / dry : 0.0;
+  printf("triage %.1f s mean (%.1f s max), full offset correction %.1f s mean\n",
+         meanTriage, maxTriageSec, meanCorrection);
+  if (meanCorrection > 0.0) {
+    printf("a passing part costs %.0f%% of a full correction; triage pays off while "
+           "fewer than %.0f%% of parts need correcting\n",
+           100.0 * meanTriage / meanCorrection, 100.0 * (1.0 - meanTriage / meanCorrection));
+  }
+}
+
+// ============================================================================
+// COMBINED DRY + OFFSET
+// Soaked parts (default settings): condensation removal then offset
+// correction on the same part, against the combined single heat cycle.
+// Also checks the saving the firmware reports against the measured one.
+// ============================================================================
+
+static void evaluateCombined() {
+  MaintenanceObserver quiet;
+  unsigned int total = 0, seqOk = 0, combOk = 0, compared = 0;
+  double seqSec = 0.0, combSec = 0.0, savedSec = 0.0, estimatedSec = 0.0, estimateErr = 0.0;
+  double seqError = 0.0, combError = 0.0;
+  uint32_t seed = 1;
+
+  for (size_t t = 0; t < COUNT(AMBIENT_TEMP_GRID); t++)
+    for (size_t h = 0; h < COUNT(AMBIENT_RH_GRID); h++)
+      for (size_t d = 0; d < COUNT(DRIFT_GRID); d++)
+        for (size_t w = 0; w < COUNT(CONDENSATE_GRID); w++) {
+          SimConditions c;
+          c.ambientTemp = AMBIENT_TEMP_GRID[t];
+          c.ambientHumidity = AMBIENT_RH_GRID[h];
+          c.humidityDrift = DRIFT_GRID[d];
+          c.condensate = CONDENSATE_GRID[w];
+          c.tempNoise = 0.05;
+          c.humidityNoise = 0.1;
+          c.seed = seed++ * 2654435761u;
+          total++;
+
+          // Two operations back to back, as an operator would run them
+          SimulatedHdc seq(c);
+          MaintenanceResult cr, oc;
+          bool seqSuccess =
+              maintenanceCondensationRemoval(seq, DEFAULT_CONDENSATION_PARAMS, quiet, cr) &&
+              maintenanceOffsetCorrection(seq, DEFAULT_OFFSET_PARAMS, quiet, oc);
+
+          SimulatedHdc comb(c);
+          MaintenanceResult result;
+          CombinedResult combined;
+          bool combSuccess = maintenanceCombined(comb, DEFAULT_CONDENSATION_PARAMS,
+                                                 DEFAULT_OFFSET_PARAMS, quiet, result, combined);
+
+          if (seqSuccess) seqOk++;
+          if (combSuccess) combOk++;
+          if (!seqSuccess || !combSuccess) continue;
+
+          double written, writtenTemp;
+          seq.readOffsets(writtenTemp, written);
+          seqError += fabs(written + c.humidityDrift);
+          comb.readOffsets(writtenTemp, written);
+          combError += fabs(written + c.humidityDrift);
+
+          double sequential = (cr.durationMs + oc.durationMs) / 1000.0;
+          double saved = sequential - result.durationMs / 1000.0;
+          seqSec += sequential;
+          combSec += result.durationMs / 1000.0;
+          savedSec += saved;
+          estimatedSec += combined.savedMs / 1000.0;
+          estimateErr += fabs(combined.savedMs / 1000.0 - saved);
+          compared++;
+        }
+
+  printf("\n=== COMBINED DRY + OFFSET (default settings, %u soaked parts) ===\n", total);
+  printf("succeeded: sequential %u, combined %u\n", seqOk, combOk);
+  if (compared == 0) return;
+  printf("sequential %.1f s mean, combined %.1f s mean, %.1f s saved per part\n",
+         seqSec / compared, combSec / compared, savedSec / compared);
+  printf("reported saving %.1f s mean, %.1f s mean error\n", estimatedSec / compared,
+         estimateErr / compared);
+  printf("offset error: sequential %.3f %%RH, combined %.3f %%RH mean\n", seqError / compared,
+         combError / compared);
+}
+
+int main(int argc, char** argv) {
+  unsigned int threads = std::thread::hardware_concurrency();
+  const char* csvPath = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+      threads = (unsigned int)atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+      csvPath = argv[++i];
+    } else {
+      fprintf(stderr, "usage: sweep [-j threads] [--csv all.csv]\n");
+      return 2;
+    }
+  }
+  if (threads == 0) threads = 1;
+
+  std::vector<SimConditions> crConditions = buildConditions(MAINT_OP_CONDENSATION);
+  std::vector<SimConditions> ocConditions = buildConditions(MAINT_OP_OFFSET_CORRECTION);
+  std::vector<Candidate> cands;
+  buildCandidates(cands);
+
+  printf("Sweeping %u candidates x %u/%u conditions on %u threads\n",
+         (unsigned)cands.size(), (unsigned)crConditions.size(),
+         (unsigned)ocConditions.size(), threads);
+
+  // Work queue: each worker claims the next unevaluated candidate
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> pool;
+  for (unsigned int t = 0; t < threads; t++) {
+    pool.push_back(std::thread([&]() {
+      for (size_t i = next++; i < cands.size(); i = next++) {
+        Candidate& c = cands[i];
+        evaluate(c, c.operation == MAINT_OP_CONDENSATION ? crConditions : ocConditions);
+      }
+    }));
+  }
+  for (size_t t = 0; t < pool.size(); t++) {
+    pool[t].join();
+  }
+
+  markPareto(cands, MAINT_OP_CONDENSATION);
+  markPareto(cands, MAINT_OP_OFFSET_CORRECTION);
+
+  printFront(cands, MAINT_OP_CONDENSATION, "CONDENSATION REMOVAL");
+  printFront(cands, MAINT_OP_OFFSET_CORRECTION, "OFFSET CORRECTION");
+  evaluateTriage();
+  evaluateCombined();
+
+  if (csvPath != NULL) {
+    FILE* f = fopen(csvPath, "w");
+    if (f == NULL) {
+      fprintf(stderr, "Cannot write %s\n", csvPath);
+      return 1;
+    }
+    fprintf(f, "operation,heater,poll_ms,timeout_ms,exit_rh,cooldown_ms,lut_scale,ramp_mode,plateau_mode,"
+               "mean_cycle_s,max_cycle_s,mean_error,success_pct,pareto\n");
+    for (size_t i = 0; i < cands.size(); i++) {
+      printCandidate(f, cands[i], true);
+    }
+    fclose(f);
+  }
+
+  return 0;
+}
@@ -0,0 +1,294 @@
+// ============================================================================
+// HDC TRACE CONVERTER (host)
+// Pulls the event trace from a maintenance unit over USB (TRACE command), or
+// reads a saved serial log containing a dump, and writes Chrome trace JSON
+// for chrome://tracing or ui.perfetto.dev.
+//
+//   pio run -e native_trace
+//   .pio/build/native_trace/program /dev/ttyACM0 -o trace.json
+//   .pio/build/native_trace/program serial.log -o trace.json
+//
+// All events go on one track ("loop"), nested as they ran; the heater is a
+// counter track. A summary of time spent per event is printed to stderr.
+// ============================================================================
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "HdcBackend.h"
+#include "Maintenance.h"
+#include "SerialPort.h"
+#include "TraceCodec.h"
+
+#define READ_TIMEOUT_MS 3000
+#define TRACE_PID 1
+#define TRACE_TID 1
+
+// ============================================================================
+// INPUT
+// ============================================================================
+
+static int inputFd = -1;
+static bool inputIsTty = false;
+
+static bool openInput(const char* path) {
+  inputFd = serialInputOpen(path);
+  if (inputFd < 0) return false;
+  inputIsTty = isatty(inputFd);
+  return true;
+}
+
+// One line without the line ending; false on EOF or timeout
+static bool readLine(std::string& line) {
+  line.clear();
+  for (;;) {
+    struct pollfd pfd;
+    pfd.fd = inputFd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, READ_TIMEOUT_MS) <= 0) return false;
+
+    char c;
+    ssize_t n = read(inputFd, &c, 1);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) continue;
+      return !line.empty();
+    }
+    if (c == '\n') return true;
+    if (c != '\r') line += c;
+  }
+}
+
+// ============================================================================
+// DUMP
+// ============================================================================
+
+struct TraceDump {
+  unsigned long dropped;
+  std::map<unsigned, std::string> taskNames;
+  std::vector<TraceEvent> events;
+};
+
+// Everything between the "TRACE <n> <dropped>" header and "TRACE END". A
+// log with several dumps keeps the last one.
+static bool readDump(TraceDump& dump) {
+  std::string line;
+  bool inDump = false, complete = false;
+
+  while (readLine(line)) {
+    unsigned long count, dropped;
+    unsigned task;
+    char name[64];
+    TraceEvent event;
+
+    if (sscanf(line.c_str(), "TRACE %lu %lu", &count, &dropped) == 2) {
+      dump.dropped = dropped;
+      dump.taskNames.clear();
+      dump.events.clear();
+      dump.events.reserve(count);
+      inDump = true;
+      complete = false;
+    } else if (!inDump) {
+      continue;
+    } else if (sscanf(line.c_str(), "TRACE TASK %u %63s", &task, name) == 2) {
+      dump.taskNames[task] = name;
+    } else if (parseTraceEvent(line.c_str(), event)) {
+      dump.events.push_back(event);
+    } else if (line == "TRACE END") {
+      inDump = false;
+      complete = true;
+      // A live unit sends one dump; a log file may hold more
+      if (inputIsTty) break;
+    }
+  }
+  return complete;
+}
+
+// ============================================================================
+// CHROME TRACE JSON
+// ============================================================================
+
+static std::string eventName(const TraceDump& dump, const TraceEvent& e) {
+  static const char* const SLOTS[] = { "LP0", "LP1", "LP2", "LP3", "auto" };
+  char buf[64];
+
+  switch (e.id) {
+    case TRACE_EVT_TASK: {
+      std::map<unsigned, std::string>::const_iterator it = dump.taskNames.find(e.arg);
+      if (it != dump.taskNames.end()) return it->second;
+      snprintf(buf, sizeof(buf), "task %u", (unsigned)e.arg);
+      return buf;
+    }
+    case TRACE_EVT_SENSOR_READ:
+      snprintf(buf, sizeof(buf), "sensor read %s", e.arg <= HDC_MODE_COUNT ? SLOTS[e.arg] : "?");
+      return buf;
+    case TRACE_EVT_LOG_WRITE:
+      return e.arg ? "log write + erase" : "log write";
+    case TRACE_EVT_OPERATION:
+      switch (e.arg) {
+        case MAINT_OP_CONDENSATION:      return "condensation removal";
+        case MAINT_OP_OFFSET_CORRECTION: return "offset correction";
+        case MAINT_OP_TRIAGE:            return "triage";
+        case MAINT_OP_COMBINED:          return "combined dry + offset";
+        default:                         return "operation";
+      }
+    case TRACE_EVT_BUTTON:
+      snprintf(buf, sizeof(buf), "button %c", 'A' + (e.arg < 3 ? e.arg : 0));
+      return buf;
+    default:
+      return traceEventName(e.id);
+  }
+}
+
+// Per-name time for the summary
+struct SpanStats {
+  unsigned long count;
+  double totalUs;
+  double maxUs;
+};
+
+// Follows the metadata events, so always after a comma
+static void writeSlice(FILE* out, const std::string& name, const char* category,
+                       char phase, double ts) {
+  fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.0f,\"pid\":%d,\"tid\":%d%s}",
+          name.c_str(), category, phase, ts, TRACE_PID, TRACE_TID,
+          phase == 'i' ? ",\"s\":\"t\"" : "");
+}
+
+static void writeJson(FILE* out, const TraceDump& dump, std::map<std::string, SpanStats>& stats,
+                      unsigned long& orphans) {
+  struct Open {
+    uint8_t id;
+    std::string name;
+    double ts;
+  };
+  std::vector<Open> stack;
+  double ts = 0.0;
+
+  fprintf(out, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%lu},\"traceEvents\":[", dump.dropped);
+  fprintf(out, "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"HDC maintenance station\"}}",
+          TRACE_PID);
+  fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"loop\"}}",
+          TRACE_PID, TRACE_TID);
+
+  for (size_t i = 0; i < dump.events.size(); i++) {
+    const TraceEvent& e = dump.events[i];
+    // Relative to the first event; micros() wraps every ~71 minutes
+    if (i > 0) ts += (uint32_t)(e.timeUs - dump.events[i - 1].timeUs);
+    const char* category = traceEventName(e.id);
+    std::string name = eventName(dump, e);
+
+    if (e.phase == TRACE_BEGIN) {
+      Open o;
+      o.id = e.id;
+      o.name = name;
+      o.ts = ts;
+      stack.push_back(o);
+      writeSlice(out, name, category, 'B', ts);
+    } else if (e.phase == TRACE_END) {
+      // The begin may have been overwritten in the ring
+      if (stack.empty() || stack.back().id != e.id) {
+        orphans++;
+        continue;
+      }
+      SpanStats& s = stats[stack.back().name];
+      double us = ts - stack.back().ts;
+      s.count++;
+      s.totalUs += us;
+      if (us > s.maxUs) s.maxUs = us;
+      writeSlice(out, stack.back().name, category, 'E', ts);
+      stack.pop_back();
+    } else if (e.id == TRACE_EVT_HEATER) {
+      fprintf(out, ",\n{\"name\":\"heater\",\"ph\":\"C\",\"ts\":%.0f,\"pid\":%d,\"args\":{\"on\":%d}}",
+              ts, TRACE_PID, e.arg != HDC_HEATER_OFF ? 1 : 0);
+      writeSlice(out, e.arg != HDC_HEATER_OFF ? "heater on" : "heater off", category, 'i', ts);
+    } else {
+      writeSlice(out, name, category, 'i', ts);
+    }
+  }
+
+  // Still open when the dump was taken (e.g. the command that sent it)
+  while (!stack.empty()) {
+    writeSlice(out, stack.back().name, traceEventName(stack.back().id), 'E', ts);
+    stack.pop_back();
+  }
+  fprintf(out, "\n]}\n");
+}
+
+static void printSummary(const TraceDump& dump, const std::map<std::string, SpanStats>& stats,
+                         unsigned long orphans) {
+  double spanUs = 0.0;
+  for (size_t i = 1; i < dump.events.size(); i++) {
+    spanUs += (uint32_t)(dump.events[i].timeUs - dump.events[i - 1].timeUs);
+  }
+
+  fprintf(stderr, "%lu events over %.3f s, %lu overwritten in the ring, %lu ends without a begin\n",
+          (unsigned long)dump.events.size(), spanUs / 1e6, dump.dropped, orphans);
+  fprintf(stderr, "%-24s %7s %11s %10s %10s\n", "event", "count", "total ms", "mean ms", "max ms");
+  for (std::map<std::string, SpanStats>::const_iterator it = stats.begin(); it != stats.end(); ++it) {
+    const SpanStats& s = it->second;
+    fprintf(stderr, "%-24s %7lu %11.1f %10.3f %10.3f\n", it->first.c_str(), s.count,
+            s.totalUs / 1000.0, s.totalUs / 1000.0 / s.count, s.maxUs / 1000.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* inputPath = NULL;
+  const char* outputPath = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      outputPath = argv[++i];
+    } else if (argv[i][0] != '-' && inputPath == NULL) {
+      inputPath = argv[i];
+    } else {
+      inputPath = NULL;
+      break;
+    }
+  }
+
+  if (inputPath == NULL) {
+    fprintf(stderr, "usage: trace_convert <port|serial.log> [-o trace.json]\n");
+    return 2;
+  }
+  if (!openInput(inputPath)) {
+    fprintf(stderr, "Cannot open %s\n", inputPath);
+    return 2;
+  }
+
+  if (inputIsTty) {
+    static const char cmd[] = "TRACE\n";
+    if (write(inputFd, cmd, sizeof(cmd) - 1) != (ssize_t)(sizeof(cmd) - 1)) {
+      fprintf(stderr, "Failed to send TRACE command\n");
+      return 1;
+    }
+  }
+
+  TraceDump dump;
+  dump.dropped = 0;
+  if (!readDump(dump)) {
+    fprintf(stderr, "No complete trace dump received\n");
+    return 1;
+  }
+
+  FILE* out = outputPath != NULL ? fopen(outputPath, "w") : stdout;
+  if (out == NULL) {
+    fprintf(stderr, "Cannot write %s\n", outputPath);
+    return 2;
+  }
+
+  std::map<std::string, SpanStats> stats;
+  unsigned long orphans = 0;
+  writeJson(out, dump, stats, orphans);
+  if (out != stdout) fclose(out);
+
+  printSummary(dump, stats, orphans);
+  return 0;
+}
@@ -3,6 +3,22 @@
 #include <Adafruit_HDC302x.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SH110X.h>
+#include <Maintenance.h>
+#include <Capture.h>
+#include <TextFormat.h>
+#include <SensorCodec.h>
+#include <StationProtocol.h>
+#include "SensorInfo.h"
+#include "FieldDisplay.h"
+#include "Screens.h"
+#include "DisplayBench.h"
+#include "SampleLog.h"
+#include "LogExport.h"
+#include "Scheduler.h"
+#include "MeasureStats.h"
+#include "MemoryStats.h"
+#include "Trace.h"
+#include "RecipeStore.h"
 
 // ============================================================================
 // HDC SENSOR MAINTENANCE UTILITY
@@ -23,7 +39,7 @@
 
 // Initialize objects
 Adafruit_HDC302x hdc;
-Adafruit_SH1107 display(SCREEN_HEIGHT, SCREEN_WIDTH, &Wire, OLED_RESET, 1000000, 100000);
+FieldDisplay display(SCREEN_HEIGHT, SCREEN_WIDTH, &Wire, OLED_RESET, 1000000, 100000);
 
 // Menu states
 enum MenuState {
@@ -32,12 +48,16 @@ enum MenuState {
   MENU_CONDENSATION = 2,
   MENU_OFFSET_CORRECTION = 3,
   MENU_RESET_OFFSETS = 4,
-  MENU_RUNNING_OPERATION = 5
+  MENU_RUNNING_OPERATION = 5,
+  MENU_DIAGNOSTICS = 6,
+  MENU_TRIAGE = 7,
+  MENU_COMBINED = 8
 };
 
 MenuState currentMenu = MENU_MAIN;
 uint8_t menuSelection = 0;
-const uint8_t MENU_ITEMS = 4;
+bool diagnosticsMemoryPage = false;  // Diagnostics shows tasks or memory
+const uint8_t MENU_ITEMS = MAIN_MENU_ITEMS;
 
 // Button state variables
 bool buttonAPressed = false;
@@ -49,26 +69,25 @@ bool buttonCLastState = false;
 unsigned long lastButtonPress = 0;
 #define BUTTON_DEBOUNCE 200
 
-// Sensor data
-struct SensorInfo {
-  bool connected;
-  uint8_t i2c_address;
-  uint64_t nist_id;
-  double temperature;
-  double humidity;
-  double temp_offset;
-  double humidity_offset;
-  bool heater_on;
-  unsigned long last_reading;
-};
-
+// Sensor data (see SensorInfo.h)
 SensorInfo sensor;
 
-// Display update timing
-unsigned long lastDisplayUpdate = 0;
+// Task timing (ms)
+#define SENSOR_READ_INTERVAL 1000
+#define LOG_INTERVAL 1000
+#define BUTTON_SCAN_INTERVAL 10
+#define SERIAL_POLL_INTERVAL 20
 #define DISPLAY_UPDATE_INTERVAL 500
+#define MEMORY_CHECK_INTERVAL 1000
 #define CONFIRMATION_DISPLAY_TIME 2000  // Time to show confirmation screen (ms)
 
+// Measurement modes. Maintenance operations choose LP0..LP3 per phase
+// (see MeasureModePolicy); between operations the sensor free-runs in
+// auto-measurement mode at the display rate so a read just fetches the
+// latest result.
+#define IDLE_AUTO_MODE AUTO_MEASUREMENT_1MPS_LP0
+#define MODE_TEST_READS 32  // Back-to-back reads per mode for MODES TEST
+
 // Function prototypes
 void initializeSensor();
 void readSensorData();
@@ -76,21 +95,114 @@ void readNISTID();
 void readCurrentOffsets();
 void updateDisplay();
 void handleButtons();
+void handleSerialCommands();
+void logSampleTask();
+void memoryCheckTask();
+void startIdleMeasurements();
+void stopIdleMeasurements();
+bool timedRead(HdcMeasureMode mode, double& temp, double& humidity, uint32_t& waitUs);
+void testMeasureModes(Print& out);
 void displayMainMenu();
 void displaySensorInfo();
-void displayConfirmation(String operation);
-void runCondensationRemoval();
-void runOffsetCorrection();
+void displayDiagnostics();
+void displayConfirmation(const char* operation);
+void runCondensationRemoval(bool waitForButton);
+void runOffsetCorrection(bool waitForButton);
+void runTriage(bool waitForButton);
+void runCombined(bool waitForButton);
+void waitForAnyButton();
+bool loadRecipe(MaintenanceOperation op, Recipe& recipe);
+void sendStationResult(const StationResult& station);
 void resetOffsets();
 bool performCondensationRemoval(double& finalTemp, double& finalHumidity);
 bool performOffsetErrorCorrection(double& tempOffset, double& humidityOffset);
-void updateOperationDisplay(String title, String status, float temp, float humidity, float tempRise, int elapsedSec);
+bool performTriage(TriageResult& triage, const char*& failure);
+bool performCombined(double& humidityOffset, CombinedResult& combined, const char*& failure);
+void updateOperationDisplay(const char* title, const char* status, float temp, float humidity, float tempRise, int elapsedSec);
+
+// ============================================================================
+// HARDWARE BINDINGS FOR THE MAINTENANCE ALGORITHMS
+// ============================================================================
+
+// Adafruit_HDC302x + Arduino time base
+class ArduinoHdcBackend : public HdcBackend {
+public:
+  ArduinoHdcBackend() : mode(HDC_MODE_LP0) {}
+
+  bool readTemperatureHumidity(double& temperature, double& humidity) {
+    uint32_t waitUs;
+    bool ok = timedRead(mode, temperature, humidity, waitUs);
+    if (ok) {
+      measureStats.recordRead(mode, waitUs, temperature, humidity, !sensor.heater_on);
+    } else {
+      measureStats.recordFailure(mode, waitUs);
+    }
+    return ok;
+  }
+
+  void setMeasureMode(HdcMeasureMode m) { mode = m; }
+
+  bool heaterEnable(HdcHeaterPower power) {
+    traceBuffer.instant(TRACE_EVT_HEATER, power);
+    bool ok;
+    switch (power) {
+      case HDC_HEATER_FULL_POWER:    ok = hdc.heaterEnable(HEATER_FULL_POWER); break;
+      case HDC_HEATER_HALF_POWER:    ok = hdc.heaterEnable(HEATER_HALF_POWER); break;
+      case HDC_HEATER_QUARTER_POWER: ok = hdc.heaterEnable(HEATER_QUARTER_POWER); break;
+      default:                       ok = hdc.heaterEnable(HEATER_OFF); break;
+    }
+    if (ok) sensor.heater_on = (power != HDC_HEATER_OFF);
+    return ok;
+  }
+
+  bool writeOffsets(double tempOffset, double humidityOffset) {
+    return hdc.writeOffsets(tempOffset, humidityOffset);
+  }
+
+  bool readOffsets(double& tempOffset, double& humidityOffset) {
+    return hdc.readOffsets(tempOffset, humidityOffset);
+  }
+
+  unsigned long millis() { return ::millis(); }
+  void delay(unsigned long ms) { ::delay(ms); }
+
+private:
+  HdcMeasureMode mode;
+};
+
+// Capture lines go to Serial alongside the normal log
+class SerialCaptureSink : public CaptureSink {
+public:
+  void writeLine(const char* line) { Serial.println(line); }
+};
+
+// Serial log + OLED progress during maintenance operations
+class SerialMaintenanceObserver : public MaintenanceObserver {
+public:
+  void onMessage(const char* message) {
+    Serial.println(message);
+  }
+
+  void onReport(const MaintenanceReport& r);
+
+  void onProgress(const char* title, const char* status, float temp,
+                  float humidity, float tempRise, int elapsedSec) {
+    updateOperationDisplay(title, status, temp, humidity, tempRise, elapsedSec);
+  }
+};
+
+ArduinoHdcBackend hdcBackend;
+SerialCaptureSink serialCapture;
+bool idleAutoMode = false;  // Sensor free-running in IDLE_AUTO_MODE
 
 // ============================================================================
 // SETUP
 // ============================================================================
 
 void setup() {
+  // Before anything deepens the stack
+  memoryStats.begin();
+  
   Serial.begin(115200);
   Serial.println("\n=== HDC Sensor Maintenance Utility ===");
   Serial.println("Version 1.0");
@@ -110,6 +222,7 @@ void setup() {
   }
   
   display.setRotation(1);
+  display.beginFields();
   display.clearDisplay();
   display.setTextSize(1);
   display.setTextColor(SH110X_WHITE);
@@ -149,6 +262,9 @@ void setup() {
   readNISTID();
   readCurrentOffsets();
   
+  // Mount the sample log (QSPI flash)
+  sampleLog.begin();
+  
   // Display success
   display.clearDisplay();
   display.setCursor(0, 0);
@@ -157,16 +273,7 @@ void setup() {
   display.println(sensor.i2c_address, HEX);
   display.println();
   display.print("NIST ID:");
-  // Format as 6-byte (48-bit) hex value: XX:XX:XX:XX:XX:XX
-  char nistStr[18];
-  sprintf(nistStr, "%02X%02X%02X%02X%02X%02X",
-          (uint8_t)((sensor.nist_id >> 40) & 0xFF),
-          (uint8_t)((sensor.nist_id >> 32) & 0xFF),
-          (uint8_t)((sensor.nist_id >> 24) & 0xFF),
-          (uint8_t)((sensor.nist_id >> 16) & 0xFF),
-          (uint8_t)((sensor.nist_id >> 8) & 0xFF),
-          (uint8_t)(sensor.nist_id & 0xFF));
-  display.println(nistStr);
+  display.println(sensor.nist_str);
   display.println();
   display.println("Ready!");
   display.display();
@@ -175,11 +282,19 @@ void setup() {
   Serial.print("I2C Address: 0x");
   Serial.println(sensor.i2c_address, HEX);
   Serial.print("NIST ID: 0x");
-  Serial.println(nistStr);
+  Serial.println(sensor.nist_str);
   
   delay(2000);
   
-  lastDisplayUpdate = millis();
+  startIdleMeasurements();
+  
+  // Periodic tasks: name, function, period, budget (ms), priority
+  scheduler.addPeriodic("buttons", handleButtons, BUTTON_SCAN_INTERVAL, 2, 4);
+  scheduler.addPeriodic("sensor", readSensorData, SENSOR_READ_INTERVAL, 50, 3);
+  scheduler.addPeriodic("display", updateDisplay, DISPLAY_UPDATE_INTERVAL, 40, 2);
+  scheduler.addPeriodic("log", logSampleTask, LOG_INTERVAL, 20, 1);
+  scheduler.addPeriodic("serial", handleSerialCommands, SERIAL_POLL_INTERVAL, 5, 1);
+  scheduler.addPeriodic("memory", memoryCheckTask, MEMORY_CHECK_INTERVAL, 5, 0);
 }
 
 // ============================================================================
@@ -187,22 +302,9 @@ void setup() {
 // ============================================================================
 
 void loop() {
-  unsigned long currentMillis = millis();
-  
-  // Read sensor data periodically
-  if (currentMillis - sensor.last_reading >= 1000) {
-    readSensorData();
-    sensor.last_reading = currentMillis;
-  }
-  
-  // Handle button presses
-  handleButtons();
-  
-  // Update display
-  if (currentMillis - lastDisplayUpdate >= DISPLAY_UPDATE_INTERVAL) {
-    updateDisplay();
-    lastDisplayUpdate = currentMillis;
-  }
+  // Sensor reads, button scan, display refresh, logging and serial commands
+  // are all scheduler tasks (registered at the end of setup())
+  scheduler.run();
 }
 
 // ============================================================================
@@ -213,6 +315,7 @@ void initializeSensor() {
   sensor.connected = false;
   sensor.i2c_address = 0;
   sensor.nist_id = 0;
+  formatNistId(sensor.nist_str, 0);
   sensor.heater_on = false;
   
   // Try primary address
@@ -238,23 +341,114 @@ void readSensorData() {
   if (!sensor.connected) return;
   
   double temp, humidity;
-  if (hdc.readTemperatureHumidityOnDemand(temp, humidity, TRIGGERMODE_LP0)) {
+  bool ok;
+  if (idleAutoMode) {
+    // Latest free-running result - no conversion wait
+    uint32_t start = micros();
+    traceBuffer.begin(TRACE_EVT_SENSOR_READ, MEASURE_SLOT_AUTO);
+    ok = hdc.readAutoTempRH(temp, humidity);
+    traceBuffer.end(TRACE_EVT_SENSOR_READ, MEASURE_SLOT_AUTO);
+    uint32_t waitUs = micros() - start;
+    if (ok) {
+      measureStats.recordRead(MEASURE_SLOT_AUTO, waitUs, temp, humidity, true);
+    } else {
+      measureStats.recordFailure(MEASURE_SLOT_AUTO, waitUs);
+    }
+  } else {
+    ok = hdcBackend.readTemperatureHumidity(temp, humidity);
+  }
+  
+  if (ok) {
     sensor.temperature = temp;
     sensor.humidity = humidity;
+    computeDerivedMetrics((float)temp, (float)humidity, sensor.derived);
+    sensor.last_reading = millis();
+  }
+}
+
+// ============================================================================
+// MEASUREMENT MODES
+// ============================================================================
+
+static hdcTriggerMode triggerModeFor(HdcMeasureMode mode) {
+  switch (mode) {
+    case HDC_MODE_LP1: return TRIGGERMODE_LP1;
+    case HDC_MODE_LP2: return TRIGGERMODE_LP2;
+    case HDC_MODE_LP3: return TRIGGERMODE_LP3;
+    default:           return TRIGGERMODE_LP0;
+  }
+}
+
+// One on-demand read; waitUs = trigger to result (conversion + I2C)
+bool timedRead(HdcMeasureMode mode, double& temp, double& humidity, uint32_t& waitUs) {
+  uint32_t start = micros();
+  traceBuffer.begin(TRACE_EVT_SENSOR_READ, mode);
+  bool ok = hdc.readTemperatureHumidityOnDemand(temp, humidity, triggerModeFor(mode));
+  traceBuffer.end(TRACE_EVT_SENSOR_READ, mode);
+  waitUs = micros() - start;
+  return ok;
+}
+
+void startIdleMeasurements() {
+  // Falls back to on-demand LP0 reads if the sensor refuses
+  idleAutoMode = hdc.setAutoMode(IDLE_AUTO_MODE);
+}
+
+void stopIdleMeasurements() {
+  // On-demand commands, the heater and offset writes need the sensor idle
+  if (idleAutoMode) {
+    hdc.setAutoMode(EXIT_AUTO_MODE);
+    delay(1);
+  }
+  idleAutoMode = false;
+  hdcBackend.setMeasureMode(HDC_MODE_LP0);
+}
+
+void testMeasureModes(Print& out) {
+  MeasureStats test;
+  
+  stopIdleMeasurements();
+  for (uint8_t m = 0; m < HDC_MODE_COUNT; m++) {
+    for (uint8_t i = 0; i < MODE_TEST_READS; i++) {
+      double temp, humidity;
+      uint32_t waitUs;
+      if (timedRead((HdcMeasureMode)m, temp, humidity, waitUs)) {
+        test.recordRead(m, waitUs, temp, humidity, true);
+      } else {
+        test.recordFailure(m, waitUs);
+      }
+    }
   }
+  startIdleMeasurements();
+  
+  out.print("MODES TEST ");
+  out.print(MODE_TEST_READS);
+  out.println(" back-to-back reads per mode, heater off");
+  test.printStats(out);
+}
+
+void logSampleTask() {
+  // Only log fresh readings - a failed read leaves last_reading unchanged
+  static unsigned long lastLogged = 0;
+  if (!sensor.connected || sensor.last_reading == lastLogged) return;
+  
+  sampleLog.logSample(sensor.temperature, sensor.humidity);
+  lastLogged = sensor.last_reading;
+}
+
+void memoryCheckTask() {
+  // Scans the painted stack area - about a millisecond with RAM mostly free
+  memoryStats.update();
 }
 
 void readNISTID() {
   sensor.nist_id = 0;
   
   // Read NIST ID directly from the sensor using the library function
-  uint8_t nist_bytes[6];
+  uint8_t nist_bytes[HDC_NIST_ID_BYTES];
   if (hdc.readNISTID(nist_bytes)) {
     // Convert 6-byte array to uint64_t
-    sensor.nist_id = 0;
-    for (int i = 0; i < 6; i++) {
-      sensor.nist_id |= ((uint64_t)nist_bytes[i]) << ((5 - i) * 8);
-    }
+    sensor.nist_id = packNistId(nist_bytes);
     
     Serial.print("Successfully read NIST ID from sensor: 0x");
     // Display as 6-byte (48-bit) hex value
@@ -267,6 +461,9 @@ void readNISTID() {
     Serial.println("ERROR: Failed to read NIST ID from sensor");
     sensor.nist_id = 0;
   }
+  
+  // Formatted once here - the info screen just copies the string
+  formatNistId(sensor.nist_str, sensor.nist_id);
 }
 
 void readCurrentOffsets() {
@@ -295,6 +492,9 @@ void updateDisplay() {
     case MENU_SENSOR_INFO:
       displaySensorInfo();
       break;
+    case MENU_DIAGNOSTICS:
+      displayDiagnostics();
+      break;
     case MENU_RUNNING_OPERATION:
       // Display is updated by operation functions
       break;
@@ -305,101 +505,25 @@ void updateDisplay() {
 }
 
 void displayMainMenu() {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setCursor(0, 0);
-  
-  // Title
-  display.println("=== MAIN MENU ===");
-  display.println();
-  
-  // Menu items
-  const char* menuItems[] = {
-    "1.View Sensor Info",
-    "2.Condensation Rem.",
-    "3.Offset Correction",
-    "4.Reset Offsets"
-  };
-  
-  for (uint8_t i = 0; i < MENU_ITEMS; i++) {
-    if (i == menuSelection) {
-      display.print("> ");
-    } else {
-      display.print("  ");
-    }
-    display.println(menuItems[i]);
-  }
-  
-  // Current values footer
-  display.setCursor(0, 56);
-  display.print("T:");
-  display.print(sensor.temperature, 1);
-  display.print("C RH:");
-  display.print(sensor.humidity, 1);
-  display.print("%");
-  
+  drawMainMenuScreen(display, menuSelection, sensor);
   display.display();
 }
 
 void displaySensorInfo() {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setCursor(0, 0);
-  
-  // Title
-  display.println("SENSOR INFO");
-  display.println("------------");
-  
-  // NIST ID - display as 6-byte (48-bit) hex value
-  display.print("ID:");
-  char nistStr[13];  // 12 hex digits + null terminator
-  sprintf(nistStr, "%02X%02X%02X%02X%02X%02X",
-          (uint8_t)((sensor.nist_id >> 40) & 0xFF),
-          (uint8_t)((sensor.nist_id >> 32) & 0xFF),
-          (uint8_t)((sensor.nist_id >> 24) & 0xFF),
-          (uint8_t)((sensor.nist_id >> 16) & 0xFF),
-          (uint8_t)((sensor.nist_id >> 8) & 0xFF),
-          (uint8_t)(sensor.nist_id & 0xFF));
-  
-  // // Display on one or two lines based on length
-  // if (strlen(nistStr) > 10) {
-  //   // Display first 6 digits on first line
-  //   char line1[7];
-  //   strncpy(line1, nistStr, 6);
-  //   line1[6] = '\0';
-  //   display.println(line1);
-    
-  //   // Display remaining 6 digits on second line with indent
-  //   display.print("  ");
-  //   display.println(&nistStr[6]);
-  // } else {
-    display.println(nistStr);
-  // }
-  
-  // Current readings
-  display.print("Temp: ");
-  display.print(sensor.temperature, 1);
-  display.println("C");
-  
-  display.print("RH:   ");
-  display.print(sensor.humidity, 1);
-  display.println("%");
-  
-  // Current offsets
-  display.println("Offsets:");
-  display.print(" T:");
-  display.print(sensor.temp_offset, 2);
-  display.print(" RH:");
-  display.println(sensor.humidity_offset, 2);
-  
-  // Footer
-  display.setCursor(0, 56);
-  display.print("Press C to exit");
-  
+  drawSensorInfoScreen(display, sensor);
   display.display();
 }
 
-void displayConfirmation(String operation) {
+void displayDiagnostics() {
+  if (diagnosticsMemoryPage) {
+    drawMemoryScreen(display);
+  } else {
+    drawDiagnosticsScreen(display);
+  }
+  display.display();
+}
+
+void displayConfirmation(const char* operation) {
   display.clearDisplay();
   display.setTextSize(1);
   display.setCursor(0, 0);
@@ -415,42 +539,8 @@ void displayConfirmation(String operation) {
   display.display();
 }
 
-void updateOperationDisplay(String title, String status, float temp, float humidity, float tempRise, int elapsedSec) {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setCursor(0, 0);
-  
-  // Line 1: Title
-  display.println(title);
-  display.println("------------");
-  
-  // Line 2: Temperature with rise
-  display.print("T:");
-  display.print(temp, 1);
-  display.print("C");
-  if (tempRise > 0) {
-    display.print(" (+");
-    display.print(tempRise, 1);
-    display.print(")");
-  }
-  display.println();
-  
-  // Line 3: Humidity
-  display.print("RH:");
-  display.print(humidity, 1);
-  display.println("%");
-  
-  // Line 4: Time elapsed
-  if (elapsedSec > 0) {
-    display.print("Time:");
-    display.print(elapsedSec);
-    display.println("s");
-  }
-  display.println();
-  
-  // Line 5: Status
-  display.println(status);
-  
+void updateOperationDisplay(const char* title, const char* status, float temp, float humidity, float tempRise, int elapsedSec) {
+  drawOperationScreen(display, title, status, temp, humidity, tempRise, elapsedSec);
   display.display();
 }
 
@@ -476,6 +566,9 @@ void handleButtons() {
   bool buttonAEdge = buttonAState && !buttonALastState;
   bool buttonBEdge = buttonBState && !buttonBLastState;
   bool buttonCEdge = buttonCState && !buttonCLastState;
+  if (buttonAEdge) traceBuffer.instant(TRACE_EVT_BUTTON, 0);
+  if (buttonBEdge) traceBuffer.instant(TRACE_EVT_BUTTON, 1);
+  if (buttonCEdge) traceBuffer.instant(TRACE_EVT_BUTTON, 2);
   
   // Update last states
   buttonALastState = buttonAState;
@@ -513,20 +606,41 @@ void handleButtons() {
           case 1: // Condensation Removal
             displayConfirmation("CONDENSATION\nREMOVAL");
             delay(CONFIRMATION_DISPLAY_TIME);
+            scheduler.ignoreCurrentRun();
             currentMenu = MENU_CONDENSATION;
             break;
             
           case 2: // Offset Correction
             displayConfirmation("OFFSET ERROR\nCORRECTION");
             delay(CONFIRMATION_DISPLAY_TIME);
+            scheduler.ignoreCurrentRun();
             currentMenu = MENU_OFFSET_CORRECTION;
             break;
             
           case 3: // Reset Offsets
             displayConfirmation("RESET OFFSETS\nTO ZERO");
             delay(CONFIRMATION_DISPLAY_TIME);
+            scheduler.ignoreCurrentRun();
             currentMenu = MENU_RESET_OFFSETS;
             break;
+            
+          case 4: // Diagnostics
+            currentMenu = MENU_DIAGNOSTICS;
+            break;
+            
+          case 5: // Quick Triage
+            displayConfirmation("QUICK\nTRIAGE");
+            delay(CONFIRMATION_DISPLAY_TIME);
+            scheduler.ignoreCurrentRun();
+            currentMenu = MENU_TRIAGE;
+            break;
+            
+          case 6: // Combined Dry + Offset
+            displayConfirmation("DRY + OFFSET\nCORRECTION");
+            delay(CONFIRMATION_DISPLAY_TIME);
+            scheduler.ignoreCurrentRun();
+            currentMenu = MENU_COMBINED;
+            break;
         }
       }
       break;
@@ -539,11 +653,36 @@ void handleButtons() {
       }
       break;
       
+    case MENU_DIAGNOSTICS:
+      if (buttonAEdge) {
+        // Switch between the task and memory pages
+        diagnosticsMemoryPage = !diagnosticsMemoryPage;
+        lastButtonPress = millis();
+      }
+      
+      if (buttonBEdge) {
+        // Reset the statistics on the current page
+        if (diagnosticsMemoryPage) {
+          memoryStats.resetPeaks();
+        } else {
+          scheduler.resetStats();
+        }
+        lastButtonPress = millis();
+      }
+      
+      if (buttonCEdge) {
+        // Exit back to main menu
+        currentMenu = MENU_MAIN;
+        lastButtonPress = millis();
+      }
+      break;
+      
     case MENU_CONDENSATION:
       if (buttonAEdge) {
         // Confirm - run condensation removal
         currentMenu = MENU_RUNNING_OPERATION;
-        runCondensationRemoval();
+        runCondensationRemoval(true);
+        scheduler.ignoreCurrentRun();
         currentMenu = MENU_MAIN;
         lastButtonPress = millis();
       }
@@ -559,7 +698,42 @@ void handleButtons() {
       if (buttonAEdge) {
         // Confirm - run offset correction
         currentMenu = MENU_RUNNING_OPERATION;
-        runOffsetCorrection();
+        runOffsetCorrection(true);
+        scheduler.ignoreCurrentRun();
+        currentMenu = MENU_MAIN;
+        lastButtonPress = millis();
+      }
+      
+      if (buttonCEdge) {
+        // Cancel
+        currentMenu = MENU_MAIN;
+        lastButtonPress = millis();
+      }
+      break;
+      
+    case MENU_TRIAGE:
+      if (buttonAEdge) {
+        // Confirm - run triage
+        currentMenu = MENU_RUNNING_OPERATION;
+        runTriage(true);
+        scheduler.ignoreCurrentRun();
+        currentMenu = MENU_MAIN;
+        lastButtonPress = millis();
+      }
+      
+      if (buttonCEdge) {
+        // Cancel
+        currentMenu = MENU_MAIN;
+        lastButtonPress = millis();
+      }
+      break;
+      
+    case MENU_COMBINED:
+      if (buttonAEdge) {
+        // Confirm - run the combined operation
+        currentMenu = MENU_RUNNING_OPERATION;
+        runCombined(true);
+        scheduler.ignoreCurrentRun();
         currentMenu = MENU_MAIN;
         lastButtonPress = millis();
       }
@@ -575,6 +749,7 @@ void handleButtons() {
       if (buttonAEdge) {
         // Confirm - reset offsets
         resetOffsets();
+        scheduler.ignoreCurrentRun();
         currentMenu = MENU_MAIN;
         lastButtonPress = millis();
       }
@@ -592,15 +767,184 @@ void handleButtons() {
   }
 }
 
+// ============================================================================
+// SERIAL COMMANDS
+// One command per line from the host:
+//   EXPORT [seq]  stream the sample log from record seq (default: oldest)
+//   LOGINFO       print the log's record range
+//   LOGCLEAR      erase the log
+//   SCHED         print scheduler task statistics
+//   SCHED RESET   clear scheduler task statistics
+//   BENCH         display renderer cycles/frame (field vs. full redraw)
+//   MODES         conversion wait / noise seen per measurement mode
+//   MODES TEST    measure every on-demand mode back to back
+//   MODES RESET   clear the measurement mode statistics
+//   MEM           RAM use: static, heap, stack high water (MemoryStats.h)
+//   MEM RESET     repaint the stack and restart the peaks
+//   TRACE         dump the event trace (TraceCodec.h)
+//   TRACE CLEAR   empty the trace buffer
+//   TRACE ON/OFF  start / stop recording events
+//   ID            re-read the NIST ID, reply ID,<nist> (StationProtocol.h)
+//   RUN COND      condensation removal without the button prompts
+//   RUN OFFSET    offset error correction without the button prompts
+//   RUN TRIAGE    quick triage without the button prompts
+//   RUN COMBINED  condensation removal + offset correction in one heat cycle
+//   RECIPE        list the stored maintenance recipes (RecipeStore.h)
+//   RECIPE LOAD <hex>  store an encoded recipe in its operation's slot
+//   RECIPE CLEAR <op>  back to the built-in procedure for op
+// ============================================================================
+
+// Long enough for RECIPE LOAD with the largest recipe
+#define SERIAL_COMMAND_MAX (16 + 2 * RECIPE_MAX_SIZE)
+
+char serialCommand[SERIAL_COMMAND_MAX];
+uint16_t serialCommandLength = 0;
+
+// Exactly "EXPORT" (from the oldest record) or "EXPORT <seq>"
+bool parseExportCommand(const char* command, uint32_t& fromSeq) {
+  fromSeq = 0;
+  if (strcmp(command, "EXPORT") == 0) return true;
+  if (strncmp(command, "EXPORT ", 7) != 0 || !isdigit(command[7])) return false;
+  char* end;
+  fromSeq = strtoul(command + 7, &end, 10);
+  return *end == '\0';
+}
+
+void handleSerialCommands() {
+  while (Serial.available() > 0) {
+    char c = Serial.read();
+    
+    if (c != '\n' && c != '\r') {
+      if (serialCommandLength < SERIAL_COMMAND_MAX - 1) {
+        serialCommand[serialCommandLength++] = c;
+      }
+      continue;
+    }
+    
+    if (serialCommandLength == 0) continue;
+    serialCommand[serialCommandLength] = '\0';
+    serialCommandLength = 0;
+    
+    traceBuffer.begin(TRACE_EVT_SERIAL_COMMAND);
+    uint32_t fromSeq;
+    if (parseExportCommand(serialCommand, fromSeq)) {
+      exportSampleLog(Serial, fromSeq);
+      scheduler.ignoreCurrentRun();
+    } else if (strcmp(serialCommand, "LOGINFO") == 0) {
+      Serial.print("LOG ");
+      Serial.print(sampleLog.firstSeq());
+      Serial.print(" ");
+      Serial.print(sampleLog.endSeq());
+      Serial.print(" boot ");
+      Serial.println(sampleLog.bootNumber());
+    } else if (strcmp(serialCommand, "LOGCLEAR") == 0) {
+      sampleLog.clear();
+      scheduler.ignoreCurrentRun();
+      Serial.println("LOG cleared");
+    } else if (strcmp(serialCommand, "SCHED") == 0) {
+      scheduler.printStats(Serial);
+    } else if (strcmp(serialCommand, "SCHED RESET") == 0) {
+      scheduler.resetStats();
+      Serial.println("SCHED reset");
+    } else if (strcmp(serialCommand, "MODES") == 0) {
+      measureStats.printStats(Serial);
+    } else if (strcmp(serialCommand, "MODES TEST") == 0) {
+      testMeasureModes(Serial);
+      scheduler.ignoreCurrentRun();
+    } else if (strcmp(serialCommand, "MODES RESET") == 0) {
+      measureStats.reset();
+      Serial.println("MODES reset");
+    } else if (strcmp(serialCommand, "MEM") == 0) {
+      memoryStats.update();
+      memoryStats.printStats(Serial);
+    } else if (strcmp(serialCommand, "MEM RESET") == 0) {
+      memoryStats.resetPeaks();
+      Serial.println("MEM reset");
+    } else if (strcmp(serialCommand, "TRACE") == 0) {
+      traceBuffer.dump(Serial);
+      scheduler.ignoreCurrentRun();
+    } else if (strcmp(serialCommand, "TRACE CLEAR") == 0) {
+      traceBuffer.clear();
+      Serial.println("TRACE cleared");
+    } else if (strcmp(serialCommand, "TRACE ON") == 0) {
+      traceBuffer.setEnabled(true);
+      Serial.println("TRACE on");
+    } else if (strcmp(serialCommand, "TRACE OFF") == 0) {
+      traceBuffer.setEnabled(false);
+      Serial.println("TRACE off");
+    } else if (strcmp(serialCommand, "ID") == 0) {
+      // The sensor may have been swapped since boot
+      stopIdleMeasurements();
+      readNISTID();
+      startIdleMeasurements();
+      char line[STATION_LINE_MAX];
+      formatStationId(sensor.nist_id, line, sizeof(line));
+      Serial.println(line);
+    } else if (strcmp(serialCommand, "RUN COND") == 0) {
+      currentMenu = MENU_RUNNING_OPERATION;
+      runCondensationRemoval(false);
+      scheduler.ignoreCurrentRun();
+      currentMenu = MENU_MAIN;
+    } else if (strcmp(serialCommand, "RUN OFFSET") == 0) {
+      currentMenu = MENU_RUNNING_OPERATION;
+      runOffsetCorrection(false);
+      scheduler.ignoreCurrentRun();
+      currentMenu = MENU_MAIN;
+    } else if (strcmp(serialCommand, "RUN TRIAGE") == 0) {
+      currentMenu = MENU_RUNNING_OPERATION;
+      runTriage(false);
+      scheduler.ignoreCurrentRun();
+      currentMenu = MENU_MAIN;
+    } else if (strcmp(serialCommand, "RUN COMBINED") == 0) {
+      currentMenu = MENU_RUNNING_OPERATION;
+      runCombined(false);
+      scheduler.ignoreCurrentRun();
+      currentMenu = MENU_MAIN;
+    } else if (strcmp(serialCommand, "RECIPE") == 0) {
+      recipeStore.printList(Serial);
+    } else if (strncmp(serialCommand, "RECIPE LOAD ", 12) == 0) {
+      uint8_t data[RECIPE_MAX_SIZE];
+      size_t len = recipeFromHex(serialCommand + 12, data, sizeof(data));
+      RecipeStatus status = len > 0 ? recipeStore.store(data, len) : RECIPE_BAD_SIZE;
+      scheduler.ignoreCurrentRun();
+      if (status == RECIPE_OK) {
+        Serial.println("RECIPE stored");
+      } else {
+        Serial.print("RECIPE error: ");
+        Serial.println(recipeStatusName(status));
+      }
+    } else if (strncmp(serialCommand, "RECIPE CLEAR ", 13) == 0) {
+      char* end;
+      unsigned long op = strtoul(serialCommand + 13, &end, 10);
+      if (end != serialCommand + 13 && *end == '\0' && op < MAINT_OP_COUNT &&
+          recipeStore.clear((MaintenanceOperation)op)) {
+        scheduler.ignoreCurrentRun();
+        Serial.println("RECIPE cleared");
+      } else {
+        Serial.println("RECIPE error: no such slot");
+      }
+    } else if (strcmp(serialCommand, "BENCH") == 0) {
+      runDisplayBenchmark(display, Serial);
+      scheduler.ignoreCurrentRun();
+    } else {
+      Serial.print("Unknown command: ");
+      Serial.println(serialCommand);
+    }
+    traceBuffer.end(TRACE_EVT_SERIAL_COMMAND);
+  }
+}
+
 // ============================================================================
 // MAINTENANCE OPERATIONS
 // ============================================================================
 
-void runCondensationRemoval() {
+void runCondensationRemoval(bool waitForButton) {
   Serial.println("\n=== Starting Condensation Removal ===");
   
   double finalTemp, finalHumidity;
+  stopIdleMeasurements();
   bool success = performCondensationRemoval(finalTemp, finalHumidity);
+  startIdleMeasurements();
   
   // Show results
   display.clearDisplay();
@@ -627,29 +971,28 @@ void runCondensationRemoval() {
     Serial.println("Condensation removal timed out");
   }
   
+  if (!waitForButton) {
+    // Started by the host - no prompt, the menu returns on the next refresh
+    display.display();
+    return;
+  }
+  
   display.println();
   display.print("Press any button");
   display.display();
-  
-  // Wait for button press
-  while (digitalRead(BUTTON_A) == HIGH && 
-         digitalRead(BUTTON_B) == HIGH && 
-         digitalRead(BUTTON_C) == HIGH) {
-    delay(10);
-  }
-  
-  // Wait for release
-  delay(300);
+  waitForAnyButton();
 }
 
-void runOffsetCorrection() {
+void runOffsetCorrection(bool waitForButton) {
   Serial.println("\n=== Starting Offset Error Correction ===");
   
   double tempOffset, humidityOffset;
+  stopIdleMeasurements();
   bool success = performOffsetErrorCorrection(tempOffset, humidityOffset);
   
   // Update stored offsets
   readCurrentOffsets();
+  startIdleMeasurements();
   
   // Show results
   display.clearDisplay();
@@ -680,19 +1023,123 @@ void runOffsetCorrection() {
     Serial.println("Offset correction failed");
   }
   
+  if (!waitForButton) {
+    // Started by the host - no prompt, the menu returns on the next refresh
+    display.display();
+    return;
+  }
+  
   display.println();
   display.print("Press any button");
   display.display();
+  waitForAnyButton();
+}
+
+void runTriage(bool waitForButton) {
+  Serial.println("\n=== Starting Quick Triage ===");
   
-  // Wait for button press
-  while (digitalRead(BUTTON_A) == HIGH && 
-         digitalRead(BUTTON_B) == HIGH && 
-         digitalRead(BUTTON_C) == HIGH) {
-    delay(10);
+  TriageResult triage;
+  const char* failure;
+  stopIdleMeasurements();
+  bool success = performTriage(triage, failure);
+  startIdleMeasurements();
+  
+  // Show results
+  display.clearDisplay();
+  display.setCursor(0, 0);
+  display.println("QUICK TRIAGE");
+  display.println();
+  
+  if (success) {
+    switch (triage.verdict) {
+      case TRIAGE_OK:
+        display.println("SENSOR OK");
+        display.println("No maintenance needed");
+        break;
+      case TRIAGE_NEEDS_OFFSET_CORRECTION:
+        display.println("NEEDS OFFSET");
+        display.println("CORRECTION");
+        break;
+      case TRIAGE_NEEDS_CONDENSATION_REMOVAL:
+        display.println("NEEDS CONDENSATION");
+        display.println("REMOVAL");
+        break;
+    }
+    display.println();
+    display.print("RH error:");
+    display.print(triage.humidityError, 1);
+    display.println("%");
+    Serial.print("Triage verdict: ");
+    Serial.println(triageVerdictName(triage.verdict));
+  } else {
+    display.println("FAILED");
+    display.println();
+    display.println(failure);
+    Serial.print("Triage failed: ");
+    Serial.println(failure);
   }
   
-  // Wait for release
-  delay(300);
+  if (!waitForButton) {
+    // Started by the host - no prompt, the menu returns on the next refresh
+    display.display();
+    return;
+  }
+  
+  display.println();
+  display.print("Press any button");
+  display.display();
+  waitForAnyButton();
+}
+
+void runCombined(bool waitForButton) {
+  Serial.println("\n=== Starting Combined Dry + Offset Correction ===");
+  
+  double humidityOffset;
+  CombinedResult combined;
+  const char* failure;
+  stopIdleMeasurements();
+  bool success = performCombined(humidityOffset, combined, failure);
+  
+  // Update stored offsets
+  readCurrentOffsets();
+  startIdleMeasurements();
+  
+  // Show results
+  display.clearDisplay();
+  display.setCursor(0, 0);
+  display.println("DRY + OFFSET");
+  display.println();
+  
+  if (success) {
+    display.println("SUCCESS!");
+    display.println();
+    display.print("RH:");
+    display.print(humidityOffset, 2);
+    display.println("%");
+    if (combined.savedMs > 0) {
+      display.print("Saved ~");
+      display.print(combined.savedMs / 1000);
+      display.println("s");
+    }
+    Serial.println("Combined dry + offset correction completed successfully");
+  } else {
+    display.println("FAILED");
+    display.println();
+    display.println(failure);
+    Serial.print("Combined dry + offset correction failed: ");
+    Serial.println(failure);
+  }
+  
+  if (!waitForButton) {
+    // Started by the host - no prompt, the menu returns on the next refresh
+    display.display();
+    return;
+  }
+  
+  display.println();
+  display.print("Press any button");
+  display.display();
+  waitForAnyButton();
 }
 
 void resetOffsets() {
@@ -706,7 +1153,8 @@ void resetOffsets() {
   display.println("sensor EEPROM...");
   display.display();
   
-  // Write zero offsets
+  // Write zero offsets (sensor must be out of auto-measurement mode)
+  stopIdleMeasurements();
   if (hdc.writeOffsets(0.0, 0.0)) {
     // Verify
     delay(100);
@@ -753,7 +1201,12 @@ void resetOffsets() {
     
     Serial.println("ERROR: Failed to write offsets");
   }
+  startIdleMeasurements();
   
+  waitForAnyButton();
+}
+
+void waitForAnyButton() {
   // Wait for button press
   while (digitalRead(BUTTON_A) == HIGH && 
          digitalRead(BUTTON_B) == HIGH && 
@@ -767,233 +1220,207 @@ void resetOffsets() {
 
 // ============================================================================
 // CORE MAINTENANCE FUNCTIONS
+// The algorithms live in lib/HdcCore so they can also run on the host
+// (replay harness). These wrappers bind them to the real sensor, Serial
+// and the OLED, and emit a capture of every run on Serial.
 // ============================================================================
 
-bool performCondensationRemoval(double& finalTemp, double& finalHumidity) {
-  double initialTemp, initialHumidity;
-  double currentTemp, currentHumidity;
-  
-  // Step 1: Read initial conditions
-  if (!hdc.readTemperatureHumidityOnDemand(initialTemp, initialHumidity, TRIGGERMODE_LP0)) {
-    Serial.println("Failed to read initial conditions");
-    return false;
-  }
-  
-  Serial.print("Initial Temp: ");
-  Serial.print(initialTemp);
-  Serial.print("°C, Initial RH: ");
-  Serial.print(initialHumidity);
-  Serial.println("%");
-  
-  // Step 2: Enable heater
-  if (!hdc.heaterEnable(HEATER_HALF_POWER)) {
-    Serial.println("Failed to enable heater");
-    return false;
-  }
-  
-  Serial.println("Heater enabled at HALF power");
-  sensor.heater_on = true;
-  
-  // Step 3: Monitor until humidity < 1% or timeout
-  unsigned long startTime = millis();
-  unsigned long timeoutMs = 300000; // 5 minutes
-  bool condensationRemoved = false;
-  
-  updateOperationDisplay("CONDENSATION", "Heating...", initialTemp, initialHumidity, 0, 0);
-  
-  while (millis() - startTime < timeoutMs) {
-    delay(5000); // 5 seconds between readings
-    
-    if (!hdc.readTemperatureHumidityOnDemand(currentTemp, currentHumidity, TRIGGERMODE_LP0)) {
-      Serial.println("Failed to read sensor during heating");
-      continue;
-    }
-    
-    float heatRise = currentTemp - initialTemp;
-    int elapsedSec = (millis() - startTime) / 1000;
-    
-    Serial.print("Temp: ");
-    Serial.print(currentTemp);
-    Serial.print("°C (+");
-    Serial.print(heatRise);
-    Serial.print("°C), RH: ");
-    Serial.print(currentHumidity);
-    Serial.print("%, Time: ");
-    Serial.print(elapsedSec);
-    Serial.println("s");
-    
-    // Update display
-    String status = "Heating...";
-    if (currentHumidity < 10.0) {
-      status = "Almost done!";
-    }
-    updateOperationDisplay("CONDENSATION", status, currentTemp, currentHumidity, heatRise, elapsedSec);
-    
-    // Check if condensation is removed
-    if (currentHumidity < 1.0) {
-      Serial.println("Condensation removed!");
-      condensationRemoved = true;
+// A stored recipe for op, announced before its capture begins
+bool loadRecipe(MaintenanceOperation op, Recipe& recipe) {
+  if (!recipeStore.load(op, recipe)) return false;
+  Serial.print("Using stored recipe ");
+  Serial.println(recipe.name);
+  return true;
+}
+
+// Machine-readable outcome for a host driving the station
+void sendStationResult(const StationResult& station) {
+  char line[STATION_LINE_MAX];
+  formatStationResult(station, line, sizeof(line));
+  Serial.println(line);
+}
+
+void SerialMaintenanceObserver::onReport(const MaintenanceReport& r) {
+  switch (r.event) {
+    case MAINT_EVT_INITIAL:
+      Serial.print("Initial Temp: ");
+      Serial.print(r.temperature);
+      Serial.print("°C, Initial RH: ");
+      Serial.print(r.humidity);
+      Serial.println("%");
+      break;
+
+    case MAINT_EVT_TARGET_RISE:
+      Serial.print("Target temperature rise: ");
+      Serial.print(r.rise);
+      Serial.println("°C");
+      break;
+
+    case MAINT_EVT_SAMPLE:
+      Serial.print("Temp: ");
+      Serial.print(r.temperature);
+      if (r.operation == MAINT_OP_CONDENSATION || r.operation == MAINT_OP_COMBINED) {
+        Serial.print("°C (+");
+        Serial.print(r.rise);
+        Serial.print("°C), RH: ");
+        Serial.print(r.humidity);
+        Serial.print("%, Time: ");
+        Serial.print(r.elapsedMs / 1000);
+        Serial.println("s");
+      } else {
+        Serial.print("°C, Rise: ");
+        Serial.print(r.rise);
+        Serial.print("°C, RH: ");
+        Serial.print(r.humidity);
+        Serial.println("%");
+      }
+      break;
+
+    case MAINT_EVT_OFFSET_CALCULATED:
+      Serial.print("Calculated humidity offset: ");
+      Serial.print(r.humidity);
+      Serial.println("% RH");
+      break;
+
+    case MAINT_EVT_OFFSET_VERIFIED:
+      Serial.print("Verified offsets - Temp: ");
+      Serial.print(r.temperature);
+      Serial.print("°C, RH: ");
+      Serial.print(r.humidity);
+      Serial.println("%");
+      break;
+
+    case MAINT_EVT_FINAL:
+      Serial.print("Final Temp: ");
+      Serial.print(r.temperature);
+      Serial.print("°C, Final RH: ");
+      Serial.print(r.humidity);
+      Serial.println("%");
+      break;
+
+    case MAINT_EVT_CORRECTED:
+      Serial.print("Corrected readings - Temp: ");
+      Serial.print(r.temperature);
+      Serial.print("°C, RH: ");
+      Serial.print(r.humidity);
+      Serial.println("%");
+      break;
+
+    case MAINT_EVT_TRIAGE:
+      Serial.print("Pulse rise: ");
+      Serial.print(r.rise);
+      Serial.print("°C, Estimated RH error: ");
+      Serial.print(r.humidity);
+      Serial.println("%");
+      break;
+
+    case MAINT_EVT_TIME_SAVED:
+      Serial.print("Time saved vs. separate runs: ~");
+      Serial.print(r.elapsedMs / 1000);
+      Serial.println("s");
       break;
-    }
   }
-  
-  // Step 4: Disable heater
-  hdc.heaterEnable(HEATER_OFF);
-  sensor.heater_on = false;
-  Serial.println("Heater disabled");
-  
-  if (!condensationRemoved) {
-    Serial.println("WARNING: Timeout reached");
+}
+
+bool performCondensationRemoval(double& finalTemp, double& finalHumidity) {
+  RecordingBackend recorder(hdcBackend, serialCapture);
+  SerialMaintenanceObserver observer;
+  MaintenanceResult result;
+
+  Recipe recipe;
+  bool useRecipe = loadRecipe(MAINT_OP_CONDENSATION, recipe);
+  traceBuffer.begin(TRACE_EVT_OPERATION, MAINT_OP_CONDENSATION);
+  recorder.begin(MAINT_OP_CONDENSATION, useRecipe ? recipe.name : NULL);
+  bool success;
+  if (useRecipe) {
+    success = maintenanceRunRecipe(recorder, recipe, observer, result);
+  } else {
+    success = maintenanceCondensationRemoval(recorder, DEFAULT_CONDENSATION_PARAMS, observer, result);
   }
-  
-  // Step 5: Cooldown
-  Serial.println("Cooling down...");
-  updateOperationDisplay("CONDENSATION", "Cooling...", currentTemp, currentHumidity, 0, 0);
-  delay(10000);
-  
-  // Step 6: Read final conditions
-  hdc.readTemperatureHumidityOnDemand(finalTemp, finalHumidity, TRIGGERMODE_LP0);
-  
-  Serial.print("Final Temp: ");
-  Serial.print(finalTemp);
-  Serial.print("°C, Final RH: ");
-  Serial.print(finalHumidity);
-  Serial.println("%");
-  
-  return condensationRemoved;
+  recorder.end(success);
+  traceBuffer.end(TRACE_EVT_OPERATION, MAINT_OP_CONDENSATION);
+  sampleLog.logOperation(MAINT_OP_CONDENSATION, success, result.durationMs, 0.0);
+  StationResult station;
+  stationResultFrom(MAINT_OP_CONDENSATION, result, station);
+  sendStationResult(station);
+
+  finalTemp = result.finalTemp;
+  finalHumidity = result.finalHumidity;
+  return success;
 }
 
 bool performOffsetErrorCorrection(double& tempOffset, double& humidityOffset) {
-  // Look-Up Table for temperature rise
-  const float LUT[8][4] = {
-    {32.99, 30.94, 31.78, 31.92},  // 10% RH
-    {36.36, 34.06, 36.43, 37.85},  // 15% RH  
-    {40.33, 38.16, 41.44, 43.37},  // 20% RH
-    {44.13, 42.31, 45.45, 46.89},  // 25% RH
-    {47.14, 45.81, 48.01, 48.39},  // 30% RH
-    {49.34, 48.52, 49.26, 48.99},  // 35% RH
-    {50.29, 49.79, 49.83, 49.06},  // 40% RH
-    {50.79, 50.34, 49.89, 49.06}   // 45% RH
-  };
-  
-  double initialTemp, initialHumidity;
-  double currentTemp, currentHumidity;
-  
-  // Step 1: Measure initial conditions
-  if (!hdc.readTemperatureHumidityOnDemand(initialTemp, initialHumidity, TRIGGERMODE_LP0)) {
-    Serial.println("Failed to read initial conditions");
-    return false;
-  }
-  
-  Serial.print("Initial Temp: ");
-  Serial.print(initialTemp);
-  Serial.print("°C, Initial RH: ");
-  Serial.print(initialHumidity);
-  Serial.println("%");
-  
-  // Step 2: Calculate target from LUT
-  int tempCol = constrain((int)((initialTemp - 15.0) / 5.0), 0, 3);
-  int humRow = constrain((int)((initialHumidity - 10.0) / 5.0), 0, 7);
-  
-  float targetTempRise = LUT[humRow][tempCol];
-  
-  Serial.print("Target temperature rise: ");
-  Serial.print(targetTempRise);
-  Serial.println("°C");
-  
-  // Step 3: Enable heater
-  if (!hdc.heaterEnable(HEATER_FULL_POWER)) {
-    Serial.println("Failed to enable heater");
-    return false;
-  }
-  
-  Serial.println("Heater enabled at FULL power");
-  sensor.heater_on = true;
-  
-  // Step 4: Monitor until target temperature
-  unsigned long startTime = millis();
-  unsigned long timeoutMs = 120000; // 2 minutes
-  float heatRise = 0.0;
-  
-  updateOperationDisplay("OFFSET CORR.", "Heating...", initialTemp, initialHumidity, 0, 0);
-  
-  while (millis() - startTime < timeoutMs) {
-    delay(2000); // 2 seconds between readings
-    
-    if (!hdc.readTemperatureHumidityOnDemand(currentTemp, currentHumidity, TRIGGERMODE_LP0)) {
-      Serial.println("Failed to read sensor during heating");
-      continue;
-    }
-    
-    heatRise = currentTemp - initialTemp;
-    int elapsedSec = (millis() - startTime) / 1000;
-    
-    Serial.print("Temp: ");
-    Serial.print(currentTemp);
-    Serial.print("°C, Rise: ");
-    Serial.print(heatRise);
-    Serial.print("°C, RH: ");
-    Serial.print(currentHumidity);
-    Serial.println("%");
-    
-    // Update display
-    String status = "Target:+";
-    status += String(targetTempRise, 0);
-    status += "C";
-    updateOperationDisplay("OFFSET CORR.", status, currentTemp, currentHumidity, heatRise, elapsedSec);
-    
-    // Check if target reached
-    if (heatRise >= targetTempRise) {
-      Serial.println("Target temperature reached");
-      break;
-    }
-  }
-  
-  // Step 5: Disable heater
-  hdc.heaterEnable(HEATER_OFF);
-  sensor.heater_on = false;
-  Serial.println("Heater disabled");
-  
-  // Step 6: Calculate offsets
-  humidityOffset = currentHumidity;
-  tempOffset = 0.0;
-  
-  Serial.print("Calculated humidity offset: ");
-  Serial.print(humidityOffset);
-  Serial.println("% RH");
-  
-  // Step 7: Write offsets to sensor
-  if (!hdc.writeOffsets(tempOffset, -humidityOffset)) {
-    Serial.println("Failed to write offsets");
-    return false;
-  }
-  
-  Serial.println("Offsets written to sensor");
-  
-  // Verify
-  double verifyTemp, verifyHum;
-  if (hdc.readOffsets(verifyTemp, verifyHum)) {
-    Serial.print("Verified offsets - Temp: ");
-    Serial.print(verifyTemp);
-    Serial.print("°C, RH: ");
-    Serial.print(verifyHum);
-    Serial.println("%");
+  RecordingBackend recorder(hdcBackend, serialCapture);
+  SerialMaintenanceObserver observer;
+  MaintenanceResult result;
+
+  Recipe recipe;
+  bool useRecipe = loadRecipe(MAINT_OP_OFFSET_CORRECTION, recipe);
+  traceBuffer.begin(TRACE_EVT_OPERATION, MAINT_OP_OFFSET_CORRECTION);
+  recorder.begin(MAINT_OP_OFFSET_CORRECTION, useRecipe ? recipe.name : NULL);
+  bool success;
+  if (useRecipe) {
+    success = maintenanceRunRecipe(recorder, recipe, observer, result);
+  } else {
+    success = maintenanceOffsetCorrection(recorder, DEFAULT_OFFSET_PARAMS, observer, result);
   }
-  
-  // Step 8: Cooldown
-  Serial.println("Cooling down...");
-  updateOperationDisplay("OFFSET CORR.", "Cooling...", currentTemp, currentHumidity, 0, 0);
-  delay(10000);
-  
-  // Step 9: Test corrected sensor
-  double correctedTemp, correctedHumidity;
-  if (hdc.readTemperatureHumidityOnDemand(correctedTemp, correctedHumidity, TRIGGERMODE_LP0)) {
-    Serial.print("Corrected readings - Temp: ");
-    Serial.print(correctedTemp);
-    Serial.print("°C, RH: ");
-    Serial.print(correctedHumidity);
-    Serial.println("%");
+  recorder.end(success);
+  traceBuffer.end(TRACE_EVT_OPERATION, MAINT_OP_OFFSET_CORRECTION);
+  sampleLog.logOperation(MAINT_OP_OFFSET_CORRECTION, success, result.durationMs, result.humidityOffset);
+  StationResult station;
+  stationResultFrom(MAINT_OP_OFFSET_CORRECTION, result, station);
+  sendStationResult(station);
+
+  tempOffset = result.tempOffset;
+  humidityOffset = result.humidityOffset;
+  return success;
+}
+
+bool performTriage(TriageResult& triage, const char*& failure) {
+  RecordingBackend recorder(hdcBackend, serialCapture);
+  SerialMaintenanceObserver observer;
+  MaintenanceResult result;
+
+  traceBuffer.begin(TRACE_EVT_OPERATION, MAINT_OP_TRIAGE);
+  recorder.begin(MAINT_OP_TRIAGE);
+  bool success = maintenanceTriage(recorder, DEFAULT_TRIAGE_PARAMS, observer, result, triage);
+  recorder.end(success);
+  traceBuffer.end(TRACE_EVT_OPERATION, MAINT_OP_TRIAGE);
+  sampleLog.logOperation(MAINT_OP_TRIAGE | (triage.verdict << LOG_VERDICT_SHIFT), success,
+                         result.durationMs, triage.humidityError);
+  StationResult station;
+  stationResultFromTriage(result, triage, station);
+  sendStationResult(station);
+
+  failure = result.failure;
+  return success;
+}
+
+bool performCombined(double& humidityOffset, CombinedResult& combined, const char*& failure) {
+  RecordingBackend recorder(hdcBackend, serialCapture);
+  SerialMaintenanceObserver observer;
+  MaintenanceResult result;
+
+  Recipe recipe;
+  bool useRecipe = loadRecipe(MAINT_OP_COMBINED, recipe);
+  traceBuffer.begin(TRACE_EVT_OPERATION, MAINT_OP_COMBINED);
+  recorder.begin(MAINT_OP_COMBINED, useRecipe ? recipe.name : NULL);
+  bool success;
+  if (useRecipe) {
+    combined.dryMs = combined.targetMs = combined.savedMs = 0;  // Not measured by recipes
+    success = maintenanceRunRecipe(recorder, recipe, observer, result);
+  } else {
+    success = maintenanceCombined(recorder, DEFAULT_CONDENSATION_PARAMS, DEFAULT_OFFSET_PARAMS,
+                                  observer, result, combined);
   }
-  
-  return true;
-}
\ No newline at end of file
+  recorder.end(success);
+  traceBuffer.end(TRACE_EVT_OPERATION, MAINT_OP_COMBINED);
+  sampleLog.logOperation(MAINT_OP_COMBINED, success, result.durationMs, result.humidityOffset);
+  StationResult station;
+  stationResultFromCombined(result, combined, station);
+  sendStationResult(station);
+
+  humidityOffset = result.humidityOffset;
+  failure = result.failure;
+  return success;
+}
@@ -0,0 +1,145 @@
+// ============================================================================
+// COMPUTATIONAL KERNEL BENCHMARK (host)
+// Reports ns/op for the kernels covered by test_kernels, plus the sprintf
+// NIST ID formatter they replaced. Host numbers are only comparable with
+// each other, not with the SAMD51. Each kernel must stay under a generous
+// ceiling so a gross regression (an accidental libm call per byte, a
+// per-call allocation ...) fails the run.
+//
+//   pio test -e native_test -f test_bench -v
+// ============================================================================
+
+#include <math.h>
+#include <stdio.h>
+
+#include <chrono>
+
+#include <unity.h>
+
+#include <Maintenance.h>
+#include <SensorCodec.h>
+#include <TextFormat.h>
+
+#define BENCH_OPS 1000000
+#define BENCH_RUNS 5
+
+// Keeps results live so the optimiser can't drop the loop
+static volatile uint32_t sink;
+
+void setUp() {}
+void tearDown() {}
+
+// Best-of-BENCH_RUNS time per op in ns
+template <typename Kernel>
+static double measureNs(Kernel kernel) {
+  double best = 1e30;
+  for (int run = 0; run < BENCH_RUNS; run++) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < BENCH_OPS; i++) {
+      acc += kernel(i);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    sink = acc;
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_OPS;
+    if (ns < best) best = ns;
+  }
+  return best;
+}
+
+// ceilingNs = 0 reports without a limit
+static void report(const char* name, double ns, double ceilingNs) {
+  char line[96];
+  if (ceilingNs > 0.0) {
+    snprintf(line, sizeof(line), "%-28s %8.2f ns/op  (limit %.0f)", name, ns, ceilingNs);
+  } else {
+    snprintf(line, sizeof(line), "%-28s %8.2f ns/op", name, ns);
+  }
+  TEST_MESSAGE(line);
+  if (ceilingNs > 0.0) TEST_ASSERT_LESS_THAN_DOUBLE(ceilingNs, ns);
+}
+
+// ============================================================================
+// KERNELS
+// ============================================================================
+
+static uint32_t lutKernel(uint32_t i) {
+  // Walks the whole table plus the out-of-range band on both sides
+  double t = 5.0 + (i % 37);
+  double rh = (i % 61);
+  float rise = offsetTargetRise(OFFSET_RISE_LUT, t, rh);
+  return (uint32_t)(rise * 16.0f);
+}
+
+static uint32_t packKernel(uint32_t i) {
+  uint8_t bytes[HDC_NIST_ID_BYTES] = {
+    (uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i >> 16), 0x49, 0x30, 0x22
+  };
+  return (uint32_t)packNistId(bytes);
+}
+
+static uint32_t formatKernel(uint32_t i) {
+  char buf[13];
+  formatNistId(buf, 0x544900000000ULL | i);
+  return (uint32_t)buf[11];
+}
+
+static uint32_t formatSprintfKernel(uint32_t i) {
+  // What readNISTID() did before formatNistId()
+  uint64_t nist = 0x544900000000ULL | i;
+  char buf[13];
+  snprintf(buf, sizeof(buf), "%02X%02X%02X%02X%02X%02X",
+           (uint8_t)(nist >> 40), (uint8_t)(nist >> 32), (uint8_t)(nist >> 24),
+           (uint8_t)(nist >> 16), (uint8_t)(nist >> 8), (uint8_t)nist);
+  return (uint32_t)buf[11];
+}
+
+static uint32_t fromCodeKernel(uint32_t i) {
+  uint16_t code = (uint16_t)(i * 2654435761u >> 16);
+  double t = hdcTemperatureFromCode(code);
+  double rh = hdcHumidityFromCode(code);
+  return (uint32_t)(t + rh);
+}
+
+static uint32_t toCodeKernel(uint32_t i) {
+  // Includes values outside both sensor ranges
+  double value = -60.0 + (i % 2048) * 0.1;
+  return hdcTemperatureToCode(value) + hdcHumidityToCode(value);
+}
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+
+static void bench_lut_selection() {
+  report("offsetTargetRise", measureNs(lutKernel), 200.0);
+}
+
+static void bench_nist_pack() {
+  report("packNistId", measureNs(packKernel), 100.0);
+}
+
+static void bench_nist_format() {
+  double tableNs = measureNs(formatKernel);
+  double sprintfNs = measureNs(formatSprintfKernel);
+  report("formatNistId", tableNs, 200.0);
+  report("sprintf %02X x6 (reference)", sprintfNs, 0.0);
+  TEST_ASSERT_LESS_THAN_DOUBLE(sprintfNs, tableNs);
+}
+
+static void bench_code_conversion() {
+  report("code -> T + RH", measureNs(fromCodeKernel), 100.0);
+  report("T/RH -> code (clamped)", measureNs(toCodeKernel), 200.0);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(bench_lut_selection);
+  RUN_TEST(bench_nist_pack);
+  RUN_TEST(bench_nist_format);
+  RUN_TEST(bench_code_conversion);
+
+  return UNITY_END();
+}
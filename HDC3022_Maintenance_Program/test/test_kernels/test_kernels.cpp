@@ -0,0 +1,663 @@
+// ============================================================================
+// COMPUTATIONAL KERNEL TESTS (host)
+// Correctness of the small kernels the firmware runs on every reading or
+// operation, including table edges and out-of-range input:
+//   - offset correction LUT selection (offsetTargetRise)
+//   - NIST ID packing and hex formatting
+//   - raw sensor code <-> temperature / humidity conversion
+//   - maintenance recipe encoding, validation and hex transport
+//   - station RESULT line formatting and parsing
+//   - TRACE event line formatting and parsing
+//   - sample log export chunks (delta + varint, LZ, CRC-32)
+//   - quick triage and combined dry + offset against the simulated sensor
+//     (src/host/SimulatedHdc)
+//
+//   pio test -e native_test
+// ============================================================================
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unity.h>
+
+#include <LogCodec.h>
+#include <Maintenance.h>
+#include <Recipe.h>
+#include <SensorCodec.h>
+#include <SimulatedHdc.h>
+#include <StationProtocol.h>
+#include <TextFormat.h>
+#include <TraceCodec.h>
+
+void setUp() {}
+void tearDown() {}
+
+// ============================================================================
+// LUT SELECTION
+// ============================================================================
+
+static float rise(double temp, double humidity) {
+  return offsetTargetRise(OFFSET_RISE_LUT, temp, humidity);
+}
+
+static void test_lut_every_cell() {
+  // Middle of each cell, and exactly on its lower boundary
+  for (int row = 0; row < OFFSET_LUT_ROWS; row++) {
+    for (int col = 0; col < OFFSET_LUT_COLS; col++) {
+      double t = 15.0 + 5.0 * col;
+      double rh = 10.0 + 5.0 * row;
+      TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[row][col], rise(t + 2.5, rh + 2.5));
+      TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[row][col], rise(t, rh));
+    }
+  }
+}
+
+static void test_lut_cell_boundaries() {
+  // Just below a boundary stays in the lower cell
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][0], rise(19.999, 14.999));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[1][1], rise(20.0, 15.0));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[6][2], rise(29.999, 44.999));
+}
+
+static void test_lut_table_edges() {
+  const int lastRow = OFFSET_LUT_ROWS - 1, lastCol = OFFSET_LUT_COLS - 1;
+
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][0], rise(15.0, 10.0));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][lastCol], rise(30.0, 10.0));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[lastRow][0], rise(15.0, 45.0));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[lastRow][lastCol], rise(30.0, 45.0));
+}
+
+static void test_lut_out_of_range_clamps() {
+  const int lastRow = OFFSET_LUT_ROWS - 1, lastCol = OFFSET_LUT_COLS - 1;
+
+  // Below the table, including the (x - origin) / step in (-1, 0) band
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][0], rise(14.0, 9.0));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][0], rise(-40.0, 0.0));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][0], rise(-1e30, -1e30));
+
+  // Above the table
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[lastRow][lastCol], rise(85.0, 100.0));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[lastRow][lastCol], rise(1e30, 1e30));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[lastRow][0], rise(0.0, 90.0));
+}
+
+static void test_lut_non_finite_inputs() {
+  const int lastRow = OFFSET_LUT_ROWS - 1, lastCol = OFFSET_LUT_COLS - 1;
+
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][0], rise(NAN, NAN));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][0], rise(-INFINITY, -INFINITY));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[lastRow][lastCol], rise(INFINITY, INFINITY));
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[3][0], rise(NAN, 27.0));
+}
+
+// ============================================================================
+// NIST ID
+// ============================================================================
+
+static void test_nist_pack_order() {
+  const uint8_t bytes[HDC_NIST_ID_BYTES] = { 0x54, 0x49, 0x00, 0x00, 0x30, 0x22 };
+  TEST_ASSERT_TRUE(packNistId(bytes) == 0x544900003022ULL);
+}
+
+static void test_nist_pack_extremes() {
+  const uint8_t zeros[HDC_NIST_ID_BYTES] = { 0 };
+  const uint8_t ones[HDC_NIST_ID_BYTES] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+  TEST_ASSERT_TRUE(packNistId(zeros) == 0);
+  // 48 bits only - nothing leaks above
+  TEST_ASSERT_TRUE(packNistId(ones) == 0xFFFFFFFFFFFFULL);
+}
+
+static void test_nist_format_known() {
+  char buf[13];
+  formatNistId(buf, 0x544900003022ULL);
+  TEST_ASSERT_EQUAL_STRING("544900003022", buf);
+  formatNistId(buf, 0);
+  TEST_ASSERT_EQUAL_STRING("000000000000", buf);
+  formatNistId(buf, 0xFFFFFFFFFFFFULL);
+  TEST_ASSERT_EQUAL_STRING("FFFFFFFFFFFF", buf);
+  formatNistId(buf, 0x00ABCDEF0123ULL);
+  TEST_ASSERT_EQUAL_STRING("00ABCDEF0123", buf);
+}
+
+static void test_nist_format_ignores_upper_bits() {
+  char buf[13];
+  formatNistId(buf, 0xFFFF544900003022ULL);
+  TEST_ASSERT_EQUAL_STRING("544900003022", buf);
+}
+
+static void test_nist_format_matches_sprintf() {
+  // Against the sprintf formatting the firmware used before
+  uint64_t id = 0x0123456789ABULL;
+  for (int i = 0; i < 1000; i++) {
+    id = (id * 6364136223846793005ULL + 1442695040888963407ULL);
+    uint64_t nist = id >> 16;
+
+    char expected[13], actual[13];
+    snprintf(expected, sizeof(expected), "%02X%02X%02X%02X%02X%02X",
+             (uint8_t)(nist >> 40), (uint8_t)(nist >> 32), (uint8_t)(nist >> 24),
+             (uint8_t)(nist >> 16), (uint8_t)(nist >> 8), (uint8_t)nist);
+    formatNistId(actual, nist);
+    TEST_ASSERT_EQUAL_STRING(expected, actual);
+  }
+}
+
+static void test_nist_pack_format_round_trip() {
+  const uint8_t bytes[HDC_NIST_ID_BYTES] = { 0x0A, 0xB0, 0x0C, 0xD0, 0x0E, 0xF0 };
+  char buf[13];
+  formatNistId(buf, packNistId(bytes));
+  TEST_ASSERT_EQUAL_STRING("0AB00CD00EF0", buf);
+}
+
+// ============================================================================
+// RAW CODE CONVERSION
+// ============================================================================
+
+static void test_code_range_ends() {
+  TEST_ASSERT_EQUAL_DOUBLE(-45.0, hdcTemperatureFromCode(0));
+  TEST_ASSERT_EQUAL_DOUBLE(130.0, hdcTemperatureFromCode(65535));
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, hdcHumidityFromCode(0));
+  TEST_ASSERT_EQUAL_DOUBLE(100.0, hdcHumidityFromCode(65535));
+}
+
+static void test_code_known_points() {
+  // Mid-scale and a typical room reading
+  TEST_ASSERT_DOUBLE_WITHIN(0.002, 42.5, hdcTemperatureFromCode(32768));
+  TEST_ASSERT_DOUBLE_WITHIN(0.002, 50.0, hdcHumidityFromCode(32768));
+  TEST_ASSERT_EQUAL_UINT16(25465, hdcTemperatureToCode(23.0));
+  TEST_ASSERT_EQUAL_UINT16(29491, hdcHumidityToCode(45.0));
+}
+
+static void test_code_round_trip_all() {
+  for (uint32_t code = 0; code <= 65535; code++) {
+    TEST_ASSERT_EQUAL_UINT16(code, hdcTemperatureToCode(hdcTemperatureFromCode((uint16_t)code)));
+    TEST_ASSERT_EQUAL_UINT16(code, hdcHumidityToCode(hdcHumidityFromCode((uint16_t)code)));
+  }
+}
+
+static void test_code_monotonic() {
+  for (uint32_t code = 1; code <= 65535; code++) {
+    TEST_ASSERT_TRUE(hdcTemperatureFromCode((uint16_t)code) > hdcTemperatureFromCode((uint16_t)(code - 1)));
+    TEST_ASSERT_TRUE(hdcHumidityFromCode((uint16_t)code) > hdcHumidityFromCode((uint16_t)(code - 1)));
+  }
+}
+
+static void test_code_out_of_range_clamps() {
+  TEST_ASSERT_EQUAL_UINT16(0, hdcTemperatureToCode(-100.0));
+  TEST_ASSERT_EQUAL_UINT16(65535, hdcTemperatureToCode(200.0));
+  TEST_ASSERT_EQUAL_UINT16(0, hdcHumidityToCode(-5.0));
+  TEST_ASSERT_EQUAL_UINT16(65535, hdcHumidityToCode(101.0));
+  TEST_ASSERT_EQUAL_UINT16(0, hdcTemperatureToCode(NAN));
+  TEST_ASSERT_EQUAL_UINT16(0, hdcHumidityToCode(NAN));
+  TEST_ASSERT_EQUAL_UINT16(65535, hdcHumidityToCode(INFINITY));
+  TEST_ASSERT_EQUAL_UINT16(0, hdcHumidityToCode(-INFINITY));
+}
+
+// ============================================================================
+// RECIPE CODEC
+// ============================================================================
+
+static size_t encodedOffsetRecipe(uint8_t* data) {
+  Recipe recipe;
+  recipeFromOffsetParams(DEFAULT_OFFSET_PARAMS, recipe);
+  return recipeEncode(recipe, data);
+}
+
+static void test_recipe_round_trip() {
+  Recipe in, out;
+  uint8_t data[RECIPE_MAX_SIZE];
+  recipeFromCondensationParams(DEFAULT_CONDENSATION_PARAMS, in);
+
+  size_t len = recipeEncode(in, data);
+  TEST_ASSERT_EQUAL_UINT32(RECIPE_HEADER_SIZE + in.stepCount * RECIPE_STEP_SIZE + RECIPE_CRC_SIZE, len);
+  TEST_ASSERT_EQUAL_INT(RECIPE_OK, recipeDecode(data, len, out));
+  TEST_ASSERT_EQUAL_STRING(in.name, out.name);
+  TEST_ASSERT_EQUAL_INT(in.operation, out.operation);
+  TEST_ASSERT_EQUAL_UINT8(in.stepCount, out.stepCount);
+  TEST_ASSERT_EQUAL_MEMORY(in.steps, out.steps, in.stepCount * sizeof(RecipeStep));
+}
+
+static void test_recipe_rejects_corruption() {
+  Recipe out;
+  uint8_t data[RECIPE_MAX_SIZE];
+  size_t len = encodedOffsetRecipe(data);
+
+  // Every single-bit flip is caught by the magic, version, size or CRC
+  for (size_t i = 0; i < len; i++) {
+    for (int bit = 0; bit < 8; bit++) {
+      data[i] ^= 1 << bit;
+      TEST_ASSERT_NOT_EQUAL(RECIPE_OK, recipeDecode(data, len, out));
+      data[i] ^= 1 << bit;
+    }
+  }
+  TEST_ASSERT_EQUAL_INT(RECIPE_BAD_SIZE, recipeDecode(data, len - 1, out));
+  TEST_ASSERT_EQUAL_INT(RECIPE_OK, recipeDecode(data, len, out));
+}
+
+static void test_recipe_validation() {
+  Recipe recipe;
+  int badStep;
+  recipeFromOffsetParams(DEFAULT_OFFSET_PARAMS, recipe);
+  TEST_ASSERT_EQUAL_INT(RECIPE_OK, recipeValidate(recipe, &badStep));
+
+  // Drop the cooldown: the heating step is blamed
+  recipe.stepCount--;
+  TEST_ASSERT_EQUAL_INT(RECIPE_HEATER_LEFT_ON, recipeValidate(recipe, &badStep));
+  TEST_ASSERT_EQUAL_INT(0, badStep);
+  recipe.stepCount++;
+
+  // A zero-length cooldown leaves the die hot for the final reading
+  uint16_t cooldownSec = recipe.steps[3].limitSec;
+  recipe.steps[3].limitSec = 0;
+  TEST_ASSERT_EQUAL_INT(RECIPE_HEATER_LEFT_ON, recipeValidate(recipe, &badStep));
+  TEST_ASSERT_EQUAL_INT(0, badStep);
+  recipe.steps[3].limitSec = cooldownSec;
+
+  recipe.steps[1].limitSec = RECIPE_MAX_HEAT_S + 1;
+  TEST_ASSERT_EQUAL_INT(RECIPE_HEAT_TOO_LONG, recipeValidate(recipe, &badStep));
+  TEST_ASSERT_EQUAL_INT(1, badStep);
+  recipe.steps[1].limitSec = 120;
+
+  recipe.steps[0].arg = RECIPE_HEATER_COUNT;
+  TEST_ASSERT_EQUAL_INT(RECIPE_BAD_STEP, recipeValidate(recipe, &badStep));
+  recipe.steps[0].arg = RECIPE_HEATER_FULL;
+
+  // Monitoring for less than the LUT rise would sample an unheated part
+  recipe.steps[1].value = -1;
+  TEST_ASSERT_EQUAL_INT(RECIPE_BAD_STEP, recipeValidate(recipe, &badStep));
+  TEST_ASSERT_EQUAL_INT(1, badStep);
+  recipe.steps[1].value = 0;
+
+  recipe.steps[3].limitSec = RECIPE_MAX_COOLDOWN_S + 1;
+  TEST_ASSERT_EQUAL_INT(RECIPE_BAD_STEP, recipeValidate(recipe, &badStep));
+  TEST_ASSERT_EQUAL_INT(3, badStep);
+  recipe.steps[3].limitSec = RECIPE_MAX_COOLDOWN_S;
+  TEST_ASSERT_EQUAL_INT(RECIPE_OK, recipeValidate(recipe, &badStep));
+
+  recipe.operation = MAINT_OP_TRIAGE;
+  TEST_ASSERT_EQUAL_INT(RECIPE_BAD_OPERATION, recipeValidate(recipe, &badStep));
+
+  recipeFromCombinedParams(DEFAULT_CONDENSATION_PARAMS, DEFAULT_OFFSET_PARAMS, recipe);
+  TEST_ASSERT_EQUAL_INT(RECIPE_OK, recipeValidate(recipe, &badStep));
+}
+
+static void test_recipe_hex_round_trip() {
+  uint8_t data[RECIPE_MAX_SIZE], back[RECIPE_MAX_SIZE];
+  char hex[2 * RECIPE_MAX_SIZE + 1];
+  size_t len = encodedOffsetRecipe(data);
+
+  recipeToHex(data, len, hex);
+  TEST_ASSERT_EQUAL_UINT32(2 * len, strlen(hex));
+  TEST_ASSERT_EQUAL_UINT32(len, recipeFromHex(hex, back, sizeof(back)));
+  TEST_ASSERT_EQUAL_MEMORY(data, back, len);
+
+  TEST_ASSERT_EQUAL_UINT32(2, recipeFromHex("a5Ff", back, sizeof(back)));
+  TEST_ASSERT_EQUAL_UINT8(0xA5, back[0]);
+  TEST_ASSERT_EQUAL_UINT32(0, recipeFromHex("A5F", back, sizeof(back)));
+  TEST_ASSERT_EQUAL_UINT32(0, recipeFromHex("A5G0", back, sizeof(back)));
+  TEST_ASSERT_EQUAL_UINT32(0, recipeFromHex(hex, back, len - 1));
+}
+
+// ============================================================================
+// STATION RESULT LINE
+// ============================================================================
+
+static void test_station_result_round_trip() {
+  MaintenanceResult result;
+  result.success = true;
+  result.durationMs = 43712;
+  result.tempOffset = 0.0;
+  result.humidityOffset = 2.345;
+  result.finalTemp = 24.5;
+  result.finalHumidity = 41.25;
+  CombinedResult combined;
+  combined.dryMs = 30000;
+  combined.targetMs = 15000;
+  combined.savedMs = 17500;
+
+  StationResult out, back;
+  stationResultFromCombined(result, combined, out);
+  char line[STATION_LINE_MAX];
+  formatStationResult(out, line, sizeof(line));
+  TEST_ASSERT_EQUAL_STRING("RESULT,3,1,43712,0,2345,24500,41250,0,17500", line);
+
+  TEST_ASSERT_TRUE(parseStationResult(line, back));
+  TEST_ASSERT_EQUAL_INT(MAINT_OP_COMBINED, back.operation);
+  TEST_ASSERT_EQUAL_UINT32(43712, back.durationMs);
+  TEST_ASSERT_DOUBLE_WITHIN(0.0005, 2.345, back.humidityOffset);
+  TEST_ASSERT_EQUAL_UINT32(17500, back.savedMs);
+}
+
+static void test_station_result_without_saving() {
+  StationResult back;
+
+  // Firmware from before the saving field
+  TEST_ASSERT_TRUE(parseStationResult("RESULT,1,1,18100,0,-1020,25010,49000,0", back));
+  TEST_ASSERT_EQUAL_INT(MAINT_OP_OFFSET_CORRECTION, back.operation);
+  TEST_ASSERT_EQUAL_UINT32(0, back.savedMs);
+
+  // ...and from before the triage verdict
+  TEST_ASSERT_TRUE(parseStationResult("RESULT,0,1,40100,0,0,25010,49000", back));
+  TEST_ASSERT_EQUAL_INT(MAINT_OP_CONDENSATION, back.operation);
+  TEST_ASSERT_EQUAL_INT(TRIAGE_OK, back.verdict);
+
+  TEST_ASSERT_TRUE(!parseStationResult("RESULT,1,1,18100,0,-1020,25010", back));
+  TEST_ASSERT_TRUE(!parseStationResult("RESULT,4,1,18100,0,-1020,25010,49000,0,0", back));
+}
+
+// ============================================================================
+// TRACE EVENT LINES
+// ============================================================================
+
+static void test_trace_event_round_trip() {
+  const TraceEvent events[] = {
+    { 0, TRACE_BEGIN, TRACE_EVT_TASK, 0 },
+    { 123456, TRACE_END, TRACE_EVT_OPERATION, MAINT_OP_COMBINED },
+    { 0xFFFFFFFFUL, TRACE_INSTANT, 0xFF, 0xFFFF }  // Widest line
+  };
+  char line[TRACE_LINE_MAX];
+
+  for (size_t i = 0; i < sizeof(events) / sizeof(events[0]); i++) {
+    int len = formatTraceEvent(events[i], line, sizeof(line));
+    TEST_ASSERT_TRUE(len > 0 && len < TRACE_LINE_MAX);
+
+    TraceEvent back;
+    TEST_ASSERT_TRUE(parseTraceEvent(line, back));
+    TEST_ASSERT_EQUAL_UINT32(events[i].timeUs, back.timeUs);
+    TEST_ASSERT_EQUAL_UINT8(events[i].phase, back.phase);
+    TEST_ASSERT_EQUAL_UINT8(events[i].id, back.id);
+    TEST_ASSERT_EQUAL_UINT16(events[i].arg, back.arg);
+  }
+
+  formatTraceEvent(events[1], line, sizeof(line));
+  TEST_ASSERT_EQUAL_STRING("TRACE,123456,E,4,3", line);
+}
+
+static void test_trace_event_rejects() {
+  TraceEvent event;
+  TEST_ASSERT_TRUE(!parseTraceEvent("TRACE 50 0", event));          // Header
+  TEST_ASSERT_TRUE(!parseTraceEvent("TRACE TASK 1 sensor", event));
+  TEST_ASSERT_TRUE(!parseTraceEvent("TRACE END", event));
+  TEST_ASSERT_TRUE(!parseTraceEvent("TRACE,100,X,1,0", event));     // Phase
+  TEST_ASSERT_TRUE(!parseTraceEvent("TRACE,100,B,256,0", event));   // id > 8 bits
+  TEST_ASSERT_TRUE(!parseTraceEvent("TRACE,100,B,1,65536", event)); // arg > 16 bits
+  TEST_ASSERT_TRUE(!parseTraceEvent("TRACE,100,B,1", event));
+  TEST_ASSERT_TRUE(!parseTraceEvent("CAP,100,B,1,0", event));
+}
+
+// ============================================================================
+// SAMPLE LOG CHUNKS
+// ============================================================================
+
+// A day-like stretch of the log: 1 Hz samples drifting and wrapping in
+// sign, an operation every 50 records, and a reboot halfway
+static void makeLogRecords(LogRecord* records, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    LogRecord& r = records[i];
+    bool rebooted = i >= count / 2;
+    r.boot = rebooted ? 8 : 7;
+    r.uptimeSec = rebooted ? (uint32_t)(i - count / 2) : (uint32_t)(86000 + i);
+    if (i % 50 == 49) {
+      r.type = LOG_OPERATION;
+      r.flags = MAINT_OP_TRIAGE | (TRIAGE_NEEDS_OFFSET_CORRECTION << LOG_VERDICT_SHIFT) | LOG_FLAG_SUCCESS;
+      r.a = 9;
+      r.b = -312;
+    } else {
+      r.type = LOG_SAMPLE;
+      r.flags = 0;
+      r.a = (int16_t)(2350 + (int)(i % 17) * 3 - 24);
+      r.b = (int16_t)(i < 5 ? -32768 + (int)i : 4500 - (int)(i % 29));
+    }
+  }
+}
+
+static void test_log_crc32_check_value() {
+  const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  TEST_ASSERT_EQUAL_UINT32(0xCBF43926UL, logCrc32(0, check, sizeof(check)));
+  // Continuing a CRC gives the same result as one pass
+  TEST_ASSERT_EQUAL_UINT32(0xCBF43926UL, logCrc32(logCrc32(0, check, 4), check + 4, 5));
+}
+
+static void checkChunkRoundTrip(uint32_t firstSeq, size_t count) {
+  static LogRecord in[LOG_CHUNK_MAX_RECORDS], out[LOG_CHUNK_MAX_RECORDS];
+  static uint8_t scratch[LOG_CHUNK_MAX_RAW], chunk[LOG_CHUNK_MAX_SIZE];
+  makeLogRecords(in, count);
+
+  size_t len = logBuildChunk(firstSeq, in, count, scratch, chunk);
+  TEST_ASSERT_TRUE(len <= LOG_CHUNK_MAX_SIZE);
+
+  uint32_t seq;
+  size_t n;
+  TEST_ASSERT_TRUE(logParseChunk(chunk, len, scratch, seq, out, n));
+  TEST_ASSERT_EQUAL_UINT32(firstSeq, seq);
+  TEST_ASSERT_EQUAL_UINT32(count, n);
+  TEST_ASSERT_EQUAL_MEMORY(in, out, count * sizeof(LogRecord));
+}
+
+static void test_log_chunk_full() {
+  checkChunkRoundTrip(1000, LOG_CHUNK_MAX_RECORDS);
+}
+
+static void test_log_chunk_partial() {
+  // The last chunk of an export, and the empty chunk that ends it
+  checkChunkRoundTrip(1256, 37);
+  checkChunkRoundTrip(1293, 1);
+
+  LogRecord records[LOG_CHUNK_MAX_RECORDS];
+  static uint8_t scratch[LOG_CHUNK_MAX_RAW], chunk[LOG_CHUNK_MAX_SIZE];
+  size_t len = logBuildChunk(1294, records, 0, scratch, chunk);
+  uint32_t seq;
+  size_t n = 99;
+  TEST_ASSERT_TRUE(logParseChunk(chunk, len, scratch, seq, records, n));
+  TEST_ASSERT_EQUAL_UINT32(1294, seq);
+  TEST_ASSERT_EQUAL_UINT32(0, n);
+}
+
+static void test_log_chunk_rejects_corruption() {
+  static LogRecord records[LOG_CHUNK_MAX_RECORDS];
+  static uint8_t scratch[LOG_CHUNK_MAX_RAW], chunk[LOG_CHUNK_MAX_SIZE];
+  makeLogRecords(records, 100);
+  size_t len = logBuildChunk(0, records, 100, scratch, chunk);
+  uint32_t seq;
+  size_t n;
+
+  // A flipped bit anywhere after the magic - header, payload or CRC itself
+  for (size_t i = 2; i < len; i += 7) {
+    chunk[i] ^= 0x10;
+    TEST_ASSERT_TRUE(!logParseChunk(chunk, len, scratch, seq, records, n));
+    chunk[i] ^= 0x10;
+  }
+  TEST_ASSERT_TRUE(!logParseChunk(chunk, len - 1, scratch, seq, records, n));
+  TEST_ASSERT_TRUE(logParseChunk(chunk, len, scratch, seq, records, n));
+}
+
+// ============================================================================
+// QUICK TRIAGE (simulated sensor)
+// ============================================================================
+
+// 25 C, low noise, fixed seed: the same readings every run
+static SimConditions simPart(double ambientHumidity, double drift, double condensate) {
+  SimConditions c = { 25.0, ambientHumidity, drift, condensate, 0.05, 0.1, 7 };
+  return c;
+}
+
+static bool simTriage(const SimConditions& c, const TriageParams& params, MaintenanceResult& result,
+                      TriageResult& triage) {
+  SimulatedHdc sim(c);
+  MaintenanceObserver observer;
+  return maintenanceTriage(sim, params, observer, result, triage);
+}
+
+static void test_triage_healthy_part() {
+  MaintenanceResult result;
+  TriageResult triage;
+  TEST_ASSERT_TRUE(simTriage(simPart(40.0, 0.0, 0.0), DEFAULT_TRIAGE_PARAMS, result, triage));
+  TEST_ASSERT_TRUE(result.success);
+  TEST_ASSERT_TRUE(result.failure == NULL);
+  TEST_ASSERT_EQUAL_INT(TRIAGE_OK, triage.verdict);
+  TEST_ASSERT_DOUBLE_WITHIN(DEFAULT_TRIAGE_PARAMS.offsetThreshold, 0.0, triage.humidityError);
+}
+
+static void test_triage_drifted_part() {
+  MaintenanceResult result;
+  TriageResult triage;
+  TEST_ASSERT_TRUE(simTriage(simPart(40.0, 5.0, 0.0), DEFAULT_TRIAGE_PARAMS, result, triage));
+  TEST_ASSERT_EQUAL_INT(TRIAGE_NEEDS_OFFSET_CORRECTION, triage.verdict);
+  TEST_ASSERT_DOUBLE_WITHIN(1.0, 5.0, triage.humidityError);
+}
+
+static void test_triage_soaked_part() {
+  MaintenanceResult result;
+  TriageResult triage;
+  TEST_ASSERT_TRUE(simTriage(simPart(40.0, 0.0, 2.0), DEFAULT_TRIAGE_PARAMS, result, triage));
+  TEST_ASSERT_EQUAL_INT(TRIAGE_NEEDS_CONDENSATION_REMOVAL, triage.verdict);
+}
+
+static void test_triage_pulse_too_small() {
+  // Heater off after a fraction of a degree: the RH barely moves
+  TriageParams params = DEFAULT_TRIAGE_PARAMS;
+  params.pulseRise = 0.2;
+  params.pulseTimeoutMs = 1000;
+  params.pollIntervalMs = 100;
+
+  MaintenanceResult result;
+  TriageResult triage;
+  TEST_ASSERT_TRUE(!simTriage(simPart(40.0, 5.0, 0.0), params, result, triage));
+  TEST_ASSERT_TRUE(!result.success);
+  TEST_ASSERT_EQUAL_STRING("Heat pulse too small to tell", result.failure);
+}
+
+// ============================================================================
+// COMBINED DRY + OFFSET (simulated sensor)
+// ============================================================================
+
+// The LUT target and the reading the offset was taken from
+class CombinedObserver : public MaintenanceObserver {
+public:
+  CombinedObserver() : targetRise(0), sampleRise(0), sampleMs(0) {}
+
+  void onReport(const MaintenanceReport& r) {
+    if (r.event == MAINT_EVT_TARGET_RISE) targetRise = r.rise;
+    if (r.event == MAINT_EVT_SAMPLE) {
+      sampleRise = r.rise;
+      sampleMs = r.elapsedMs;
+    }
+  }
+
+  double targetRise;
+  double sampleRise;  // Last heating sample = the offset sample
+  unsigned long sampleMs;
+};
+
+static bool simCombined(const SimConditions& c, const CondensationParams& dry, MaintenanceResult& result,
+                        CombinedResult& combined, CombinedObserver& observer) {
+  SimulatedHdc sim(c);
+  return maintenanceCombined(sim, dry, DEFAULT_OFFSET_PARAMS, observer, result, combined);
+}
+
+// Skipped cooldown + time to the target while drying, scaled to full power
+static unsigned long expectedSaving(const CombinedResult& combined) {
+  unsigned long reheatMs = combined.targetMs < combined.dryMs ? combined.targetMs : combined.dryMs;
+  return DEFAULT_CONDENSATION_PARAMS.cooldownMs + reheatMs / 2;  // Half -> full power
+}
+
+static void test_combined_still_wet() {
+  CondensationParams dry = DEFAULT_CONDENSATION_PARAMS;
+  dry.timeoutMs = 60000;
+
+  MaintenanceResult result;
+  CombinedResult combined;
+  CombinedObserver observer;
+  TEST_ASSERT_TRUE(!simCombined(simPart(40.0, -2.0, 5000.0), dry, result, combined, observer));
+  TEST_ASSERT_TRUE(!result.success);
+  TEST_ASSERT_EQUAL_STRING("Still wet, offsets not written", result.failure);
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, result.humidityOffset);
+  TEST_ASSERT_EQUAL_UINT32(0, combined.dryMs);
+  TEST_ASSERT_EQUAL_UINT32(0, combined.savedMs);
+}
+
+static void test_combined_target_while_drying() {
+  MaintenanceResult result;
+  CombinedResult combined;
+  CombinedObserver observer;
+  TEST_ASSERT_TRUE(simCombined(simPart(40.0, -2.0, 300.0), DEFAULT_CONDENSATION_PARAMS, result,
+                               combined, observer));
+  TEST_ASSERT_TRUE(result.failure == NULL);
+  TEST_ASSERT_TRUE(combined.targetMs > 0);
+  TEST_ASSERT_TRUE(combined.targetMs < combined.dryMs);
+
+  // The wet part read saturated, so the target is the top LUT row...
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[OFFSET_LUT_ROWS - 1][2], (float)observer.targetRise);
+  // ...and the offset is sampled at the dry point, well past it
+  TEST_ASSERT_TRUE(observer.sampleMs >= combined.dryMs);
+  TEST_ASSERT_TRUE(observer.sampleMs < combined.dryMs + DEFAULT_CONDENSATION_PARAMS.pollIntervalMs);
+  TEST_ASSERT_TRUE(observer.sampleRise > observer.targetRise + 10.0);
+
+  TEST_ASSERT_EQUAL_UINT32(expectedSaving(combined), combined.savedMs);
+}
+
+static void test_combined_target_after_drying() {
+  // Barely wet at 10 %RH: dry before the rise gets to the 10 %RH row's target
+  MaintenanceResult result;
+  CombinedResult combined;
+  CombinedObserver observer;
+  TEST_ASSERT_TRUE(simCombined(simPart(10.0, -2.0, 0.0), DEFAULT_CONDENSATION_PARAMS, result,
+                               combined, observer));
+  TEST_ASSERT_TRUE(combined.dryMs > 0);
+  TEST_ASSERT_TRUE(combined.dryMs < combined.targetMs);
+  TEST_ASSERT_EQUAL_FLOAT(OFFSET_RISE_LUT[0][2], (float)observer.targetRise);
+  TEST_ASSERT_TRUE(observer.sampleRise >= observer.targetRise);
+
+  TEST_ASSERT_EQUAL_UINT32(expectedSaving(combined), combined.savedMs);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_lut_every_cell);
+  RUN_TEST(test_lut_cell_boundaries);
+  RUN_TEST(test_lut_table_edges);
+  RUN_TEST(test_lut_out_of_range_clamps);
+  RUN_TEST(test_lut_non_finite_inputs);
+
+  RUN_TEST(test_nist_pack_order);
+  RUN_TEST(test_nist_pack_extremes);
+  RUN_TEST(test_nist_format_known);
+  RUN_TEST(test_nist_format_ignores_upper_bits);
+  RUN_TEST(test_nist_format_matches_sprintf);
+  RUN_TEST(test_nist_pack_format_round_trip);
+
+  RUN_TEST(test_code_range_ends);
+  RUN_TEST(test_code_known_points);
+  RUN_TEST(test_code_round_trip_all);
+  RUN_TEST(test_code_monotonic);
+  RUN_TEST(test_code_out_of_range_clamps);
+
+  RUN_TEST(test_recipe_round_trip);
+  RUN_TEST(test_recipe_rejects_corruption);
+  RUN_TEST(test_recipe_validation);
+  RUN_TEST(test_recipe_hex_round_trip);
+
+  RUN_TEST(test_station_result_round_trip);
+  RUN_TEST(test_station_result_without_saving);
+
+  RUN_TEST(test_trace_event_round_trip);
+  RUN_TEST(test_trace_event_rejects);
+
+  RUN_TEST(test_log_crc32_check_value);
+  RUN_TEST(test_log_chunk_full);
+  RUN_TEST(test_log_chunk_partial);
+  RUN_TEST(test_log_chunk_rejects_corruption);
+
+  RUN_TEST(test_triage_healthy_part);
+  RUN_TEST(test_triage_drifted_part);
+  RUN_TEST(test_triage_soaked_part);
+  RUN_TEST(test_triage_pulse_too_small);
+
+  RUN_TEST(test_combined_still_wet);
+  RUN_TEST(test_combined_target_while_drying);
+  RUN_TEST(test_combined_target_after_drying);
+
+  return UNITY_END();
+}